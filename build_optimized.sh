@@ -0,0 +1,56 @@
+# Builds the suites as plain Release, with LTO, with LTO and two-stage PGO and, if llvm-bolt is available, with BOLT on
+# top, then compares the representative benchmarks of every variant against plain Release.
+SOURCE_FOLDER="./src"
+BUILD_FOLDER_ROOT="./build"
+PGO_FOLDER="$(pwd)/build/PGO/pgo-profiles"
+SHA="$(git rev-parse HEAD)"
+
+configure_and_build() {
+    BUILD_FOLDER="${BUILD_FOLDER_ROOT}/$1"
+    shift
+    mkdir -p $BUILD_FOLDER
+    cmake -S $SOURCE_FOLDER -B $BUILD_FOLDER -DCMAKE_BUILD_TYPE=Release "$@"
+    make -C $BUILD_FOLDER --no-print-directory
+}
+
+run_representative() {
+    VARIANT="$1"
+    make -C ${BUILD_FOLDER_ROOT}/$VARIANT --no-print-directory representative_benchmarks
+    for RESULT in ${BUILD_FOLDER_ROOT}/$VARIANT/results/*.json; do
+        python3 ./tools/result_store.py ingest $RESULT --sha $SHA --variant $VARIANT
+    done
+}
+
+configure_and_build Release -DBENCHMARK_SUITE_LTO=OFF -DBENCHMARK_SUITE_PGO=
+configure_and_build LTO -DBENCHMARK_SUITE_LTO=ON -DBENCHMARK_SUITE_PGO=
+
+# PGO stages share the build folder, so that the profiles match the object files
+BOLT_OPTION="-DBENCHMARK_SUITE_BOLT=OFF"
+if command -v llvm-bolt >/dev/null; then
+    BOLT_OPTION="-DBENCHMARK_SUITE_BOLT=ON"
+fi
+rm -rf $PGO_FOLDER
+configure_and_build PGO -DBENCHMARK_SUITE_LTO=ON -DBENCHMARK_SUITE_PGO=GENERATE -DBENCHMARK_SUITE_PGO_DIRECTORY=$PGO_FOLDER $BOLT_OPTION
+make -C ${BUILD_FOLDER_ROOT}/PGO --no-print-directory representative_benchmarks
+if command -v llvm-profdata >/dev/null && ls $PGO_FOLDER/*.profraw >/dev/null 2>&1; then
+    llvm-profdata merge -o $PGO_FOLDER/default.profdata $PGO_FOLDER/*.profraw
+fi
+configure_and_build PGO -DBENCHMARK_SUITE_PGO=USE
+
+VARIANTS="LTO PGO"
+for VARIANT in Release $VARIANTS; do
+    run_representative $VARIANT
+done
+
+if [ "$BOLT_OPTION" = "-DBENCHMARK_SUITE_BOLT=ON" ]; then
+    make -C ${BUILD_FOLDER_ROOT}/PGO --no-print-directory bolt_benchmarks
+    for RESULT in ${BUILD_FOLDER_ROOT}/PGO/results/bolt/*.json; do
+        python3 ./tools/result_store.py ingest $RESULT --sha $SHA --variant PGO-BOLT
+    done
+    VARIANTS="$VARIANTS PGO-BOLT"
+fi
+
+for VARIANT in $VARIANTS; do
+    echo "=== $VARIANT against Release ==="
+    python3 ./tools/result_store.py compare --baseline sha=$SHA variant=Release --contender sha=$SHA variant=$VARIANT
+done
@@ -0,0 +1,5 @@
+EXE_NAME="$1"
+BENCHMARK_FILTER="$2"
+CALL_GRAPH="${3:-dwarf}"
+OUTPUT_NAME="$(echo "$BENCHMARK_FILTER" | tr '/:' '__')"
+./tools/perf_flamegraph.sh ./build/perf/$EXE_NAME.$OUTPUT_NAME $CALL_GRAPH ./build/RelWithDebInfo/bin/$EXE_NAME --benchmark_filter=$BENCHMARK_FILTER
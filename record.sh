@@ -0,0 +1,8 @@
+EXE_NAME="$1"
+shift
+BUILD_TYPE="${BUILD_TYPE:-Release}"
+REPETITIONS="${REPETITIONS:-10}"
+OUTPUT_FILE="./build/results.$EXE_NAME.json"
+
+./build/$BUILD_TYPE/bin/$EXE_NAME --benchmark_repetitions=$REPETITIONS --benchmark_out=$OUTPUT_FILE --benchmark_out_format=json "$@"
+python3 ./tools/result_store.py ingest $OUTPUT_FILE --binary $EXE_NAME
@@ -1,19 +1,29 @@
 #include <benchmark/benchmark.h>
 
+#include "Common/LatencyHistogram.h"
+#include "Common/MemoryTracker.h"
+#include "Common/ProfilingRegion.h"
+#include "Common/SuiteMain.h"
+
+#include <chrono>
+
 class StringOperations : public benchmark::Fixture
 {
 public:
     void SetUp(::benchmark::State& state)
     {
+        MemoryTracker::beginRun(state);
     }
 
     void TearDown(::benchmark::State& state)
     {
+        MemoryTracker::endRun(state);
     }
 };
 
 BENCHMARK_F(StringOperations, EmptyStringCreate)(benchmark::State& state)
 {
+    const auto profilingRegion = ProfilingRegion();
     for (auto _ : state)
     {
         auto output = std::string();
@@ -24,6 +34,7 @@ BENCHMARK_F(StringOperations, EmptyStringCreate)(benchmark::State& state)
 BENCHMARK_F(StringOperations, ShortStringCopy)(benchmark::State& state)
 {
     const auto shortString = std::string("Hello world!");
+    const auto profilingRegion = ProfilingRegion();
     for (auto _ : state)
     {
         auto output = std::string(shortString);
@@ -34,6 +45,7 @@ BENCHMARK_F(StringOperations, ShortStringCopy)(benchmark::State& state)
 BENCHMARK_F(StringOperations, LongStringCopy)(benchmark::State& state)
 {
     const auto longString = std::string(100000, '*');
+    const auto profilingRegion = ProfilingRegion();
     for (auto _ : state)
     {
         auto output = std::string(longString);
@@ -41,4 +53,22 @@ BENCHMARK_F(StringOperations, LongStringCopy)(benchmark::State& state)
     }
 }
 
-BENCHMARK_MAIN();
+// Times every single copy, the clock reads are part of the measured time but show how the copies are distributed
+BENCHMARK_F(StringOperations, LongStringCopyLatency)(benchmark::State& state)
+{
+    const auto longString = std::string(100000, '*');
+    auto latencies = LatencyHistogram();
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto output = std::string(longString);
+        benchmark::DoNotOptimize(output);
+        latencies.record(std::chrono::steady_clock::now() - start);
+    }
+
+    latencies.publish(state, "copy_");
+}
+
+SUITE_MAIN();
@@ -0,0 +1,101 @@
+#include "MatrixKernels.h"
+
+// Compiled once per ISA level, see add_isa_variants
+constexpr auto isaLevel = static_cast<IsaLevel>(ISA_LEVEL);
+
+namespace
+{
+// The locality hint has to be a constant. The last rows of a column have nothing left to prefetch.
+template <int Locality>
+void prefetchingForLoop(const double* a, const double* b, double* output, size_t dimension, size_t distance)
+{
+    const size_t prefetchedRows = distance < dimension ? dimension - distance : 0;
+    for (size_t i = 0; i < dimension; ++i)
+    {
+        size_t j = 0;
+        for (; j < prefetchedRows; ++j)
+        {
+            __builtin_prefetch(&a[i + (j + distance) * dimension], 0, Locality);
+            output[i] += a[i + j * dimension] + b[j];
+        }
+        for (; j < dimension; ++j)
+        {
+            output[i] += a[i + j * dimension] + b[j];
+        }
+    }
+}
+} // namespace
+
+template <>
+void MatrixKernels<isaLevel>::plainForLoop(const double* a, const double* b, double* output, size_t dimension)
+{
+    for (size_t i = 0; i < dimension; ++i)
+    {
+        for (size_t j = 0; j < dimension; ++j)
+        {
+            output[i] += a[i + j * dimension] + b[j];
+        }
+    }
+}
+
+template <>
+void MatrixKernels<isaLevel>::unrollAndJam(const double* a, const double* b, double* output, size_t dimension,
+                                           size_t unrollSize)
+{
+    for (size_t i = 0; i < dimension; i += unrollSize)
+    {
+        for (size_t j = 0; j < dimension; ++j)
+        {
+            for (size_t k = 0; k < unrollSize; ++k)
+            {
+                output[i + k] += a[i + k + j * dimension] + b[j];
+            }
+        }
+    }
+}
+
+template <>
+void MatrixKernels<isaLevel>::loopTiling(const double* a, const double* b, double* output, size_t dimension,
+                                         size_t tileSizeX, size_t tileSizeY)
+{
+    for (size_t i = 0; i < dimension; i += tileSizeX)
+    {
+        for (size_t j = 0; j < dimension; j += tileSizeY)
+        {
+            for (size_t k = 0; k < tileSizeX; ++k)
+            {
+                for (size_t m = 0; m < tileSizeY; ++m)
+                {
+                    output[i + k] += a[i + k + (j + m) * dimension] + b[j + m];
+                }
+            }
+        }
+    }
+}
+
+template <>
+void MatrixKernels<isaLevel>::plainForLoopPrefetch(const double* a, const double* b, double* output, size_t dimension,
+                                                   size_t distance, int locality)
+{
+    if (distance == 0)
+    {
+        plainForLoop(a, b, output, dimension);
+        return;
+    }
+
+    switch (locality)
+    {
+    case 0:
+        prefetchingForLoop<0>(a, b, output, dimension, distance);
+        break;
+    case 1:
+        prefetchingForLoop<1>(a, b, output, dimension, distance);
+        break;
+    case 2:
+        prefetchingForLoop<2>(a, b, output, dimension, distance);
+        break;
+    default:
+        prefetchingForLoop<3>(a, b, output, dimension, distance);
+        break;
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Common/IsaLevel.h"
+
+#include <cstddef>
+
+// Traversal kernels of the matrix benchmarks over the raw storage of a square matrix, compiled once per ISA level by
+// add_isa_variants. They compute the same as the benchmarks of the same name, output[i] += a(i, j) + b[j], but without
+// bounds checks so that the compiler is free to vectorize for the level.
+template <IsaLevel Level>
+class MatrixKernels
+{
+public:
+    static void plainForLoop(const double* a, const double* b, double* output, size_t dimension);
+    static void unrollAndJam(const double* a, const double* b, double* output, size_t dimension, size_t unrollSize);
+    static void loopTiling(const double* a, const double* b, double* output, size_t dimension, size_t tileSizeX,
+                           size_t tileSizeY);
+
+    // plainForLoop that prefetches the element the given number of rows further down the column, with the locality
+    // hint of __builtin_prefetch from 0 (no temporal locality) to 3 (keep in all cache levels). Distance 0 does not
+    // prefetch.
+    static void plainForLoopPrefetch(const double* a, const double* b, double* output, size_t dimension,
+                                     size_t distance, int locality);
+};
+
+// Defined by the variant of each level, see add_isa_variants
+template <>
+void MatrixKernels<IsaLevel::Baseline>::plainForLoop(const double* a, const double* b, double* output,
+                                                     size_t dimension);
+template <>
+void MatrixKernels<IsaLevel::Baseline>::unrollAndJam(const double* a, const double* b, double* output, size_t dimension,
+                                                     size_t unrollSize);
+template <>
+void MatrixKernels<IsaLevel::Baseline>::loopTiling(const double* a, const double* b, double* output, size_t dimension,
+                                                   size_t tileSizeX, size_t tileSizeY);
+template <>
+void MatrixKernels<IsaLevel::Baseline>::plainForLoopPrefetch(const double* a, const double* b, double* output,
+                                                             size_t dimension, size_t distance, int locality);
+
+template <>
+void MatrixKernels<IsaLevel::X86_64_V2>::plainForLoop(const double* a, const double* b, double* output,
+                                                      size_t dimension);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V2>::unrollAndJam(const double* a, const double* b, double* output,
+                                                      size_t dimension, size_t unrollSize);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V2>::loopTiling(const double* a, const double* b, double* output, size_t dimension,
+                                                    size_t tileSizeX, size_t tileSizeY);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V2>::plainForLoopPrefetch(const double* a, const double* b, double* output,
+                                                              size_t dimension, size_t distance, int locality);
+
+template <>
+void MatrixKernels<IsaLevel::X86_64_V3>::plainForLoop(const double* a, const double* b, double* output,
+                                                      size_t dimension);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V3>::unrollAndJam(const double* a, const double* b, double* output,
+                                                      size_t dimension, size_t unrollSize);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V3>::loopTiling(const double* a, const double* b, double* output, size_t dimension,
+                                                    size_t tileSizeX, size_t tileSizeY);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V3>::plainForLoopPrefetch(const double* a, const double* b, double* output,
+                                                              size_t dimension, size_t distance, int locality);
+
+template <>
+void MatrixKernels<IsaLevel::X86_64_V4>::plainForLoop(const double* a, const double* b, double* output,
+                                                      size_t dimension);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V4>::unrollAndJam(const double* a, const double* b, double* output,
+                                                      size_t dimension, size_t unrollSize);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V4>::loopTiling(const double* a, const double* b, double* output, size_t dimension,
+                                                    size_t tileSizeX, size_t tileSizeY);
+template <>
+void MatrixKernels<IsaLevel::X86_64_V4>::plainForLoopPrefetch(const double* a, const double* b, double* output,
+                                                              size_t dimension, size_t distance, int locality);
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Common/ThreadPlacement.h"
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+// Thread that walks the columns of a square matrix ahead of the thread that computes on it, and loads every element it
+// reaches so that its line and the translation of its page are already cached when the computing thread gets there.
+// On an SMT sibling that is the L1 cache and the TLB of the shared core, elsewhere only the shared cache levels.
+//
+// Positions count the elements in walk order, column after column, and keep counting over repeated walks. The
+// computing thread publishes its position now and then, and the helper stays at most distance elements ahead of it,
+// skipping forward if it fell behind.
+class PrefetchHelper
+{
+public:
+    PrefetchHelper(const double* a, size_t dimension, size_t distance, int cpu)
+        : a_(a)
+        , dimension_(dimension)
+        , distance_(distance)
+        , thread_([this, cpu] {
+            ThreadPlacement::pinCurrentThread(cpu);
+            run();
+        })
+    {
+    }
+
+    ~PrefetchHelper()
+    {
+        stop_.store(true, std::memory_order_relaxed);
+        thread_.join();
+    }
+
+    PrefetchHelper(const PrefetchHelper&) = delete;
+    PrefetchHelper& operator=(const PrefetchHelper&) = delete;
+
+    void publish(size_t position)
+    {
+        progress_.store(position, std::memory_order_relaxed);
+    }
+
+private:
+    void run()
+    {
+        const size_t numOfElements = dimension_ * dimension_;
+        size_t ahead = 0;
+        double sum = 0;
+        while (!stop_.load(std::memory_order_relaxed))
+        {
+            const size_t progress = progress_.load(std::memory_order_relaxed);
+            ahead = ahead > progress ? ahead : progress;
+            for (; ahead < progress + distance_; ++ahead)
+            {
+                const size_t element = ahead % numOfElements;
+                sum += a_[element / dimension_ + element % dimension_ * dimension_];
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        sink_ = sum;
+    }
+
+    const double* const a_;
+    const size_t dimension_;
+    const size_t distance_;
+    std::atomic<size_t> progress_{0};
+    std::atomic<bool> stop_{false};
+    volatile double sink_{0}; // Keeps the loads of the walk
+    std::thread thread_;
+};
@@ -1,24 +1,64 @@
 #include <benchmark/benchmark.h>
 
-template <typename T>
-class Matrix2D : private std::vector<T>
+#include "Common/IsaLevel.h"
+#include "Common/Matrix2D.h"
+#include "Common/MemoryTracker.h"
+#include "Common/ProfilingRegion.h"
+#include "Common/Roofline.h"
+#include "Common/SuiteMain.h"
+#include "Common/ThreadPlacement.h"
+
+#include "MatrixKernels.h"
+#include "PrefetchHelper.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Kernels of one ISA level, to be selected at runtime. Only used here, taking the addresses in MatrixKernels.cpp would
+// instantiate the kernels before their specialization
+struct MatrixKernelTable
 {
-public:
-    Matrix2D(size_t width, size_t height)
-        : std::vector<T>(width * height)
-        , width_(width)
-        , height_(height)
+    decltype(&MatrixKernels<IsaLevel::Baseline>::plainForLoop) plainForLoop;
+    decltype(&MatrixKernels<IsaLevel::Baseline>::unrollAndJam) unrollAndJam;
+    decltype(&MatrixKernels<IsaLevel::Baseline>::loopTiling) loopTiling;
+    decltype(&MatrixKernels<IsaLevel::Baseline>::plainForLoopPrefetch) plainForLoopPrefetch;
+
+    template <IsaLevel Level>
+    static constexpr MatrixKernelTable of()
     {
+        return {
+            &MatrixKernels<Level>::plainForLoop,
+            &MatrixKernels<Level>::unrollAndJam,
+            &MatrixKernels<Level>::loopTiling,
+            &MatrixKernels<Level>::plainForLoopPrefetch,
+        };
     }
 
-    T getElem(size_t x, size_t y) const
+    static MatrixKernelTable forIsa(IsaLevel level)
     {
-        return std::vector<T>::at(x + y * width_);
+        switch (level)
+        {
+        case IsaLevel::Baseline:
+            return of<IsaLevel::Baseline>();
+#if BENCHMARK_SUITE_ISA_DISPATCH
+        case IsaLevel::X86_64_V2:
+            return of<IsaLevel::X86_64_V2>();
+        case IsaLevel::X86_64_V3:
+            return of<IsaLevel::X86_64_V3>();
+        case IsaLevel::X86_64_V4:
+            return of<IsaLevel::X86_64_V4>();
+#endif
+        default:
+            throw std::runtime_error("Matrix kernels were not compiled for this ISA level!");
+        }
     }
-
-private:
-    const size_t width_;
-    const size_t height_;
 };
 
 class MatrixOperations : public benchmark::Fixture
@@ -26,22 +66,132 @@ class MatrixOperations : public benchmark::Fixture
 public:
     void SetUp(::benchmark::State& state)
     {
+        // The first benchmark fills the shared matrix before its run, so that none of them counts the page faults
+        matrix();
+        MemoryTracker::beginRun(state);
     }
 
     void TearDown(::benchmark::State& state)
     {
+        MemoryTracker::endRun(state);
     }
 
 protected:
     static constexpr size_t dimension = 1 << 14;
+
+    // Kernels of the ISA level given as first argument, none after skipping when the cpu does not support it
+    static std::optional<MatrixKernelTable> kernelsFor(benchmark::State& state)
+    {
+        const auto level = static_cast<IsaLevel>(state.range(0));
+        state.SetLabel(IsaSupport::name(level));
+        if (!IsaSupport::isSupported(level))
+        {
+            state.SkipWithError("ISA level not supported by this cpu or build");
+            return std::nullopt;
+        }
+
+        return MatrixKernelTable::forIsa(level);
+    }
+
+    // Capacity of the cache level given by its index, as detected by the pointer chasing of 3_Roofline if the file of
+    // --roofline has it, none after skipping when the machine does not have the level
+    static std::optional<size_t> cacheCapacityFor(benchmark::State& state, int64_t levelIndex)
+    {
+        const auto& levels = Roofline::memoryLevels();
+        if (levelIndex >= static_cast<int64_t>(levels.size()) - 1)
+        {
+            state.SkipWithError("Cache level not present on this machine");
+            return std::nullopt;
+        }
+
+        return Roofline::capacityOf(levels[levelIndex]);
+    }
+
+    // Whether an earlier configuration of the benchmark in this process resolved to the same sizes, after skipping if
+    // so. The sizes follow the cache capacities and are clamped to the matrix, so different arguments can end up
+    // measuring the same thing.
+    static bool skipDuplicate(benchmark::State& state, const std::string& benchmark, const std::vector<size_t>& sizes,
+                              const std::vector<int64_t>& arguments)
+    {
+        static auto firstArguments = std::map<std::pair<std::string, std::vector<size_t>>, std::vector<int64_t>>();
+        const auto& first = firstArguments.try_emplace({benchmark, sizes}, arguments).first->second;
+        if (first != arguments)
+        {
+            state.SkipWithError("Same sizes as an earlier configuration");
+            return true;
+        }
+        return false;
+    }
+
+    // Exponent of the largest power of two number of doubles that fit into the bytes
+    static int log2Doubles(size_t bytes)
+    {
+        return std::bit_width(std::max<size_t>(bytes / sizeof(double), 1)) - 1;
+    }
+
+    // Unroll size for the scale argument at the index, relative to the unroll size whose block of output fills half of
+    // the first cache level, none after skipping when the machine has no cache
+    static std::optional<size_t> unrollSizeFor(benchmark::State& state, int scaleIndex)
+    {
+        const auto capacity = cacheCapacityFor(state, 0);
+        if (!capacity)
+        {
+            return std::nullopt;
+        }
+        const int maxExponent = log2Doubles(dimension * sizeof(double));
+        return size_t{1} << std::clamp<int>(log2Doubles(*capacity / 2) + state.range(scaleIndex), 0, maxExponent);
+    }
+
+    // Tile sizes for the cache, scale and aspect arguments from the index on: tiles of a that fill half of the cache
+    // level, scaled in area and stretched along x by powers of two. None after skipping when the machine does not have
+    // the cache level.
+    static std::optional<std::pair<size_t, size_t>> tileSizesFor(benchmark::State& state, int cacheIndex)
+    {
+        const auto capacity = cacheCapacityFor(state, state.range(cacheIndex));
+        if (!capacity)
+        {
+            return std::nullopt;
+        }
+        const int maxExponent = log2Doubles(dimension * sizeof(double));
+        const int areaExponent = log2Doubles(*capacity / 2) + state.range(cacheIndex + 1);
+        const int exponentX = std::clamp<int>((areaExponent + state.range(cacheIndex + 2)) / 2, 0, maxExponent);
+        const int exponentY = std::clamp<int>(areaExponent - exponentX, 0, maxExponent);
+        return std::pair(size_t{1} << exponentX, size_t{1} << exponentY);
+    }
+
+    static std::string tileLabel(int64_t levelIndex, size_t tileSizeX, size_t tileSizeY)
+    {
+        return Roofline::memoryLevels()[levelIndex] + " tile " + std::to_string(tileSizeX) + "x" +
+               std::to_string(tileSizeY);
+    }
+
+    // Matrix a of all benchmarks, filled with random values on first use and kept for the rest of the process, so that
+    // the 2 GiB are allocated and written once instead of once per benchmark
+    static const Matrix2D<double>& matrix()
+    {
+        static const auto a = Matrix2D<double>::random(dimension, dimension, /*seed=*/1);
+        return a;
+    }
+
+    // Every kernel does two additions per element of a, reads a and b and updates output once, see Roofline
+    static void publishRoofline(benchmark::State& state, std::chrono::steady_clock::time_point start,
+                                IsaLevel isaLevel, bool simd)
+    {
+        const double flops = 2.0 * dimension * dimension;
+        const double bytes = sizeof(double) * (dimension * dimension + 3.0 * dimension);
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        Roofline::publish(state, flops, bytes, static_cast<size_t>(bytes), seconds, isaLevel, simd);
+    }
 };
 
 BENCHMARK_DEFINE_F(MatrixOperations, PlainForLoop)(benchmark::State& state)
 {
-    const auto a = Matrix2D<double>(dimension, dimension);
+    const auto& a = matrix();
     const auto b = std::vector<double>(dimension);
     auto output = std::vector<double>(dimension);
 
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
     for (auto _ : state)
     {
         for (size_t i = 0; i < dimension; ++i)
@@ -54,25 +204,38 @@ BENCHMARK_DEFINE_F(MatrixOperations, PlainForLoop)(benchmark::State& state)
 
         benchmark::DoNotOptimize(output);
     }
+
+    publishRoofline(state, start, IsaLevel::Baseline, /*simd=*/false);
 }
 BENCHMARK_REGISTER_F(MatrixOperations, PlainForLoop) //
     ->Unit(benchmark::kMillisecond);
 
 BENCHMARK_DEFINE_F(MatrixOperations, UnrollAndJam)(benchmark::State& state)
 {
-    const auto a = Matrix2D<double>(dimension, dimension);
+    const auto unrollSize = unrollSizeFor(state, 0);
+    if (!unrollSize)
+    {
+        return;
+    }
+    state.SetLabel("unroll " + std::to_string(*unrollSize));
+    if (skipDuplicate(state, "UnrollAndJam", {*unrollSize}, {state.range(0)}))
+    {
+        return;
+    }
+
+    const auto& a = matrix();
     const auto b = std::vector<double>(dimension);
     auto output = std::vector<double>(dimension);
 
-    const size_t unrollSize = state.range(0);
-
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
     for (auto _ : state)
     {
-        for (size_t i = 0; i < dimension; i += unrollSize)
+        for (size_t i = 0; i < dimension; i += *unrollSize)
         {
             for (size_t j = 0; j < dimension; ++j)
             {
-                for (size_t k = 0; k < unrollSize; ++k)
+                for (size_t k = 0; k < *unrollSize; ++k)
                 {
                     output.at(i + k) += a.getElem(i + k, j) + b.at(j);
                 }
@@ -81,22 +244,34 @@ BENCHMARK_DEFINE_F(MatrixOperations, UnrollAndJam)(benchmark::State& state)
 
         benchmark::DoNotOptimize(output);
     }
+
+    publishRoofline(state, start, IsaLevel::Baseline, /*simd=*/false);
 }
 BENCHMARK_REGISTER_F(MatrixOperations, UnrollAndJam)
     ->Unit(benchmark::kMillisecond)
-    ->ArgsProduct({
-        benchmark::CreateRange(2, 1024, /*multiplier=*/2) // Unroll size
-    });
+    ->ArgNames({"scale"})
+    ->DenseRange(-8, 2); // Unroll size relative to the first cache level as power of two
 
 BENCHMARK_DEFINE_F(MatrixOperations, LoopTiling)(benchmark::State& state)
 {
-    const auto a = Matrix2D<double>(dimension, dimension);
+    const auto tileSizes = tileSizesFor(state, 0);
+    if (!tileSizes)
+    {
+        return;
+    }
+    const auto [tileSizeX, tileSizeY] = *tileSizes;
+    state.SetLabel(tileLabel(state.range(0), tileSizeX, tileSizeY));
+    if (skipDuplicate(state, "LoopTiling", {tileSizeX, tileSizeY}, {state.range(0), state.range(1), state.range(2)}))
+    {
+        return;
+    }
+
+    const auto& a = matrix();
     const auto b = std::vector<double>(dimension);
     auto output = std::vector<double>(dimension);
 
-    const size_t tileSizeX = state.range(0);
-    const size_t tileSizeY = state.range(1);
-
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
     for (auto _ : state)
     {
         for (size_t i = 0; i < dimension; i += tileSizeX)
@@ -115,12 +290,236 @@ BENCHMARK_DEFINE_F(MatrixOperations, LoopTiling)(benchmark::State& state)
 
         benchmark::DoNotOptimize(output);
     }
+
+    publishRoofline(state, start, IsaLevel::Baseline, /*simd=*/false);
 }
 BENCHMARK_REGISTER_F(MatrixOperations, LoopTiling)
     ->Unit(benchmark::kMillisecond)
+    ->ArgNames({"cache", "scale", "aspect"})
+    ->ArgsProduct({
+        {0, 1, 2},                                      // Cache level the tile is sized for
+        benchmark::CreateDenseRange(-2, 2, /*step=*/1), // Tile area relative to the cache level as power of two
+        {-4, 0, 4},                                     // Tile width relative to its height as power of two
+    });
+
+// The same kernels without bounds checks, compiled for every x86-64 microarchitecture level and selected at runtime
+BENCHMARK_DEFINE_F(MatrixOperations, PlainForLoopPerIsa)(benchmark::State& state)
+{
+    const auto kernels = kernelsFor(state);
+    if (!kernels)
+    {
+        return;
+    }
+
+    const auto& a = matrix();
+    const auto b = std::vector<double>(dimension);
+    auto output = std::vector<double>(dimension);
+
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        kernels->plainForLoop(a.data(), b.data(), output.data(), dimension);
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    publishRoofline(state, start, static_cast<IsaLevel>(state.range(0)), /*simd=*/true);
+}
+BENCHMARK_REGISTER_F(MatrixOperations, PlainForLoopPerIsa)
+    ->Unit(benchmark::kMillisecond)
+    ->DenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4))
+    ->ArgNames({"isa"});
+
+BENCHMARK_DEFINE_F(MatrixOperations, UnrollAndJamPerIsa)(benchmark::State& state)
+{
+    const auto kernels = kernelsFor(state);
+    if (!kernels)
+    {
+        return;
+    }
+
+    const auto unrollSize = unrollSizeFor(state, 1);
+    if (!unrollSize)
+    {
+        return;
+    }
+    state.SetLabel(IsaSupport::name(static_cast<IsaLevel>(state.range(0))) + std::string(" unroll ") +
+                   std::to_string(*unrollSize));
+    if (skipDuplicate(state, "UnrollAndJamPerIsa", {static_cast<size_t>(state.range(0)), *unrollSize},
+                      {state.range(0), state.range(1)}))
+    {
+        return;
+    }
+
+    const auto& a = matrix();
+    const auto b = std::vector<double>(dimension);
+    auto output = std::vector<double>(dimension);
+
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        kernels->unrollAndJam(a.data(), b.data(), output.data(), dimension, *unrollSize);
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    publishRoofline(state, start, static_cast<IsaLevel>(state.range(0)), /*simd=*/true);
+}
+BENCHMARK_REGISTER_F(MatrixOperations, UnrollAndJamPerIsa)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgNames({"isa", "scale"})
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4),
+                                    /*step=*/1), // ISA level
+        benchmark::CreateDenseRange(-8, 2, /*step=*/1), // Unroll size relative to the first cache level as power of two
+    });
+
+BENCHMARK_DEFINE_F(MatrixOperations, LoopTilingPerIsa)(benchmark::State& state)
+{
+    const auto kernels = kernelsFor(state);
+    if (!kernels)
+    {
+        return;
+    }
+
+    const auto tileSizes = tileSizesFor(state, 1);
+    if (!tileSizes)
+    {
+        return;
+    }
+    const auto [tileSizeX, tileSizeY] = *tileSizes;
+    state.SetLabel(IsaSupport::name(static_cast<IsaLevel>(state.range(0))) + std::string(" ") +
+                   tileLabel(state.range(1), tileSizeX, tileSizeY));
+    if (skipDuplicate(state, "LoopTilingPerIsa", {static_cast<size_t>(state.range(0)), tileSizeX, tileSizeY},
+                      {state.range(0), state.range(1), state.range(2), state.range(3)}))
+    {
+        return;
+    }
+
+    const auto& a = matrix();
+    const auto b = std::vector<double>(dimension);
+    auto output = std::vector<double>(dimension);
+
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        kernels->loopTiling(a.data(), b.data(), output.data(), dimension, tileSizeX, tileSizeY);
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    publishRoofline(state, start, static_cast<IsaLevel>(state.range(0)), /*simd=*/true);
+}
+BENCHMARK_REGISTER_F(MatrixOperations, LoopTilingPerIsa)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgNames({"isa", "cache", "scale", "aspect"})
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4),
+                                    /*step=*/1), // ISA level
+        {0, 1, 2},                                      // Cache level the tile is sized for
+        benchmark::CreateDenseRange(-2, 2, /*step=*/1), // Tile area relative to the cache level as power of two
+        {-4, 0, 4},                                     // Tile width relative to its height as power of two
+    });
+
+// The column walk of PlainForLoop strides a whole row per access, across pages, which the hardware prefetcher does not
+// follow. These variants prefetch in software with the kernels of the best ISA level, or let a helper thread on
+// another cpu, preferably an SMT sibling, walk ahead.
+BENCHMARK_DEFINE_F(MatrixOperations, PlainForLoopPrefetch)(benchmark::State& state)
+{
+    const auto level = IsaSupport::best();
+    const auto kernels = MatrixKernelTable::forIsa(level);
+    state.SetLabel(IsaSupport::name(level));
+
+    const auto& a = matrix();
+    const auto b = std::vector<double>(dimension);
+    auto output = std::vector<double>(dimension);
+
+    const size_t distance = state.range(0);
+    const int locality = state.range(1);
+
+    const auto profilingRegion = ProfilingRegion();
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        kernels.plainForLoopPrefetch(a.data(), b.data(), output.data(), dimension, distance, locality);
+
+        benchmark::DoNotOptimize(output);
+    }
+
+    publishRoofline(state, start, level, /*simd=*/true);
+}
+BENCHMARK_REGISTER_F(MatrixOperations, PlainForLoopPrefetch)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgNames({"distance", "locality"})
+    ->Args({0, 0}) // Without prefetching, which ignores the locality hint
+    ->ArgsProduct({
+        {1, 2, 4, 8, 16, 32, 64, 128, 256}, // Prefetch distance in rows
+        {0, 1, 2, 3},                       // Locality hint of the prefetch
+    });
+
+// Distance 0 runs the same loop without a helper thread, as the reference for the others
+BENCHMARK_DEFINE_F(MatrixOperations, PlainForLoopHelperPrefetch)(benchmark::State& state)
+{
+    const size_t distance = state.range(0);
+    const auto cpus = ThreadPlacement::cpusFor(ThreadPlacement::Policy::Compact, 2);
+    if (distance > 0 && cpus[0] == cpus[1] && cpus[0] != -1)
+    {
+        state.SkipWithError("Helper thread needs a second cpu");
+        return;
+    }
+
+    const auto& a = matrix();
+    const auto b = std::vector<double>(dimension);
+    auto output = std::vector<double>(dimension);
+
+    // The helper learns the position of the walk every block of rows
+    constexpr size_t rowsPerBlock = 64;
+
+    ThreadPlacement::pinCurrentThread(cpus[0]);
+    {
+        auto helper = std::optional<PrefetchHelper>();
+        if (distance > 0)
+        {
+            helper.emplace(a.data(), dimension, distance, cpus[1]);
+        }
+        const double* rawA = a.data();
+        size_t position = 0;
+
+        const auto profilingRegion = ProfilingRegion();
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+        {
+            for (size_t i = 0; i < dimension; ++i)
+            {
+                for (size_t block = 0; block < dimension; block += rowsPerBlock)
+                {
+                    if (helper)
+                    {
+                        helper->publish(position + block);
+                    }
+                    for (size_t j = block; j < block + rowsPerBlock; ++j)
+                    {
+                        output[i] += rawA[i + j * dimension] + b[j];
+                    }
+                }
+                position += dimension;
+            }
+
+            benchmark::DoNotOptimize(output);
+        }
+
+        publishRoofline(state, start, IsaLevel::Baseline, /*simd=*/false);
+    }
+    ThreadPlacement::pinCurrentThread(-1);
+}
+BENCHMARK_REGISTER_F(MatrixOperations, PlainForLoopHelperPrefetch)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgNames({"distance"})
     ->ArgsProduct({
-        benchmark::CreateRange(2, 1024, /*multiplier=*/2), // Tile size for x dimension
-        benchmark::CreateRange(2, 1024, /*multiplier=*/2), // Tile size for y dimension
+        {0, 64, 256, 1024, 4096, 16384}, // Distance of the helper in elements of the walk, 0 runs without helper
     });
 
-BENCHMARK_MAIN();
+SUITE_MAIN();
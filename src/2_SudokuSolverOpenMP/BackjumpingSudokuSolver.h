@@ -0,0 +1,393 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Sequential search with forward checking and minimum remaining values order that remembers why branches fail. Every
+// value removed from the domain of a cell is tagged with the decision level that removed it, so an empty domain is
+// explained by a set of earlier decisions. With conflict-directed backjumping, a failed subtree whose explanation does
+// not contain the current decision returns straight to the latest decision it does contain, instead of trying the
+// other values of every decision in between. Optionally, the explanation of every exhausted cell is kept as a learned
+// nogood, a set of (cell, value) assignments that cannot be extended to a solution, in a ring buffer of fixed size
+// slots that overwrites the oldest one.
+template <int SudokuDimension>
+class BackjumpingSudokuSearch
+{
+public:
+    static constexpr int maxNogoodLength = 8;
+
+    BackjumpingSudokuSearch(const SudokuMap<SudokuDimension>& puzzle, bool backjumping, size_t nogoodCapacity = 0)
+        : board_(puzzle)
+        , backjumping_(backjumping)
+        , nogoodCapacity_(nogoodCapacity)
+        , nogoods_(nogoodCapacity * (maxNogoodLength + 1))
+        , watches_(nogoodCapacity > 0 ? numOfCells * (SudokuDimension + 1) : 0)
+    {
+        std::fill(std::begin(domains_), std::end(domains_), allValues);
+        std::fill(std::begin(levels_), std::end(levels_), unassigned);
+
+        for (int cell = 0; cell < numOfCells; cell++)
+        {
+            const int value = board_.getElem(cell % SudokuDimension, cell / SudokuDimension);
+            if (value != 0)
+            {
+                auto conflict = LevelSet();
+                consistent_ = consistent_ && (domains_[cell] & (uint32_t{1} << value)) && assign(cell, value, 0, conflict);
+            }
+        }
+    }
+
+    // Returns true if a solution was found, which is then on the board
+    bool solve()
+    {
+        auto conflict = LevelSet();
+        return consistent_ && search(1, conflict);
+    }
+
+    const SudokuMap<SudokuDimension>& board() const
+    {
+        return board_;
+    }
+
+    // Number of values placed so far
+    int64_t nodes() const
+    {
+        return nodes_;
+    }
+
+    // Number of times a learned nogood cut off a branch
+    int64_t nogoodHits() const
+    {
+        return nogoodHits_;
+    }
+
+private:
+    static constexpr int numOfCells = SudokuDimension * SudokuDimension;
+    static constexpr uint32_t allValues = ((uint32_t{1} << SudokuDimension) - 1) << 1;
+    static constexpr int unassigned = -1;
+
+    // Decision levels as bits, level 0 holds the clues, which never need to be explained
+    class LevelSet
+    {
+    public:
+        void set(int level)
+        {
+            if (level > 0)
+            {
+                words_[level / 64] |= uint64_t{1} << (level % 64);
+            }
+        }
+
+        void reset(int level)
+        {
+            words_[level / 64] &= ~(uint64_t{1} << (level % 64));
+        }
+
+        bool test(int level) const
+        {
+            return (words_[level / 64] >> (level % 64)) & 1;
+        }
+
+        void merge(const LevelSet& other)
+        {
+            for (size_t i = 0; i < words_.size(); i++)
+            {
+                words_[i] |= other.words_[i];
+            }
+        }
+
+        // Calls the function for every level from the lowest on
+        template <typename Function>
+        void forEach(Function function) const
+        {
+            for (size_t i = 0; i < words_.size(); i++)
+            {
+                for (auto word = words_[i]; word != 0; word &= word - 1)
+                {
+                    function(static_cast<int>(i * 64) + std::countr_zero(word));
+                }
+            }
+        }
+
+    private:
+        std::array<uint64_t, numOfCells / 64 + 1> words_{};
+    };
+
+    static constexpr int subgridSize()
+    {
+        int size = 1;
+        while (size * size < SudokuDimension)
+        {
+            size++;
+        }
+        return size;
+    }
+
+    static const std::vector<std::vector<int>>& peers()
+    {
+        static const auto peers = [] {
+            auto peers = std::vector<std::vector<int>>(numOfCells);
+            for (int cell = 0; cell < numOfCells; cell++)
+            {
+                const int x = cell % SudokuDimension;
+                const int y = cell / SudokuDimension;
+                for (int other = 0; other < numOfCells; other++)
+                {
+                    const int otherX = other % SudokuDimension;
+                    const int otherY = other / SudokuDimension;
+                    const bool sameSubgrid =
+                        x / subgridSize() == otherX / subgridSize() && y / subgridSize() == otherY / subgridSize();
+                    if (other != cell && (x == otherX || y == otherY || sameSubgrid))
+                    {
+                        peers[cell].push_back(other);
+                    }
+                }
+            }
+            return peers;
+        }();
+        return peers;
+    }
+
+    static int literal(int cell, int value)
+    {
+        return cell * (SudokuDimension + 1) + value;
+    }
+
+    // Decisions that removed the values missing from the domain of the cell
+    LevelSet eliminators(int cell) const
+    {
+        auto levels = LevelSet();
+        for (auto removed = allValues & ~domains_[cell]; removed != 0; removed &= removed - 1)
+        {
+            levels.set(eliminatedBy_[literal(cell, std::countr_zero(removed))]);
+        }
+        return levels;
+    }
+
+    // Unassigned cell with the smallest domain, or numOfCells if all are assigned
+    int nextCell() const
+    {
+        int best = numOfCells;
+        int bestCount = SudokuDimension + 1;
+        for (int cell = 0; cell < numOfCells; cell++)
+        {
+            if (levels_[cell] != unassigned)
+            {
+                continue;
+            }
+
+            const int count = std::popcount(domains_[cell]);
+            if (count < bestCount)
+            {
+                best = cell;
+                bestCount = count;
+                if (count <= 1)
+                {
+                    break;
+                }
+            }
+        }
+        return best;
+    }
+
+    // Places the value and removes it from the domains of the unassigned peers. On an empty domain or a violated
+    // nogood, returns false with the decisions that explain it.
+    bool assign(int cell, int value, int level, LevelSet& conflict)
+    {
+        board_.setElem(cell % SudokuDimension, cell / SudokuDimension, value);
+        levels_[cell] = level;
+        decisions_[level] = cell;
+
+        const uint32_t bit = uint32_t{1} << value;
+        for (const int peer : peers()[cell])
+        {
+            if (levels_[peer] != unassigned || (domains_[peer] & bit) == 0)
+            {
+                continue;
+            }
+
+            domains_[peer] &= ~bit;
+            eliminatedBy_[literal(peer, value)] = level;
+            trail_.push_back(literal(peer, value));
+            if (domains_[peer] == 0)
+            {
+                conflict = eliminators(peer);
+                return false;
+            }
+        }
+
+        return nogoodCapacity_ == 0 || !violatesNogood(literal(cell, value), conflict);
+    }
+
+    void unassign(int cell, size_t trailSize)
+    {
+        while (trail_.size() > trailSize)
+        {
+            const int removed = trail_.back();
+            trail_.pop_back();
+            domains_[removed / (SudokuDimension + 1)] |= uint32_t{1} << (removed % (SudokuDimension + 1));
+        }
+        levels_[cell] = unassigned;
+        board_.setElem(cell % SudokuDimension, cell / SudokuDimension, 0);
+    }
+
+    // On failure, the conflict holds the decisions that explain it, and the caller has to try its next value if it
+    // is one of them, or else pass the conflict on
+    bool search(int level, LevelSet& conflict)
+    {
+        const int cell = nextCell();
+        if (cell == numOfCells)
+        {
+            return true;
+        }
+
+        auto explanation = eliminators(cell);
+        for (auto values = domains_[cell]; values != 0; values &= values - 1)
+        {
+            const int value = std::countr_zero(values);
+            nodes_++;
+
+            const auto trailSize = trail_.size();
+            auto culprits = LevelSet();
+            if (assign(cell, value, level, culprits) && search(level + 1, culprits))
+            {
+                return true;
+            }
+            unassign(cell, trailSize);
+
+            if (backjumping_ && !culprits.test(level))
+            {
+                conflict = culprits;
+                return false;
+            }
+            culprits.reset(level);
+            explanation.merge(culprits);
+        }
+
+        learn(explanation);
+        conflict = explanation;
+        return false;
+    }
+
+    // Slots hold the length followed by the literals
+    void learn(const LevelSet& explanation)
+    {
+        if (nogoodCapacity_ == 0)
+        {
+            return;
+        }
+
+        int length = 0;
+        std::array<int, maxNogoodLength> literals{};
+        bool fits = true;
+        explanation.forEach([&](int level) {
+            if (length == maxNogoodLength)
+            {
+                fits = false;
+                return;
+            }
+            const int decision = decisions_[level];
+            literals[length++] = literal(decision, board_.getElem(decision % SudokuDimension, decision / SudokuDimension));
+        });
+        if (!fits || length == 0)
+        {
+            return;
+        }
+
+        const auto slot = static_cast<uint32_t>(nextNogood_++ % nogoodCapacity_);
+        auto* nogood = &nogoods_[slot * (maxNogoodLength + 1)];
+        for (int i = 0; i < nogood[0]; i++)
+        {
+            auto& watching = watches_[nogood[1 + i]];
+            watching.erase(std::find(watching.begin(), watching.end(), slot));
+        }
+
+        nogood[0] = length;
+        for (int i = 0; i < length; i++)
+        {
+            nogood[1 + i] = literals[i];
+            watches_[literals[i]].push_back(slot);
+        }
+    }
+
+    // Whether a nogood with the literal that was just assigned has all its literals assigned now
+    bool violatesNogood(int assigned, LevelSet& conflict)
+    {
+        for (const uint32_t slot : watches_[assigned])
+        {
+            const auto* nogood = &nogoods_[slot * (maxNogoodLength + 1)];
+            bool violated = true;
+            for (int i = 0; i < nogood[0] && violated; i++)
+            {
+                const int cell = nogood[1 + i] / (SudokuDimension + 1);
+                violated = board_.getElem(cell % SudokuDimension, cell / SudokuDimension) ==
+                           nogood[1 + i] % (SudokuDimension + 1);
+            }
+
+            if (violated)
+            {
+                nogoodHits_++;
+                conflict = LevelSet();
+                for (int i = 0; i < nogood[0]; i++)
+                {
+                    conflict.set(levels_[nogood[1 + i] / (SudokuDimension + 1)]);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    SudokuMap<SudokuDimension> board_;
+    const bool backjumping_;
+    const size_t nogoodCapacity_;
+    bool consistent_{true};
+
+    uint32_t domains_[numOfCells];
+    int levels_[numOfCells];                                 // Decision level of every assigned cell
+    int decisions_[numOfCells + 1]{};                        // Cell decided at every level
+    int eliminatedBy_[numOfCells * (SudokuDimension + 1)]{}; // Level that removed a value from the domain of a cell
+    std::vector<int> trail_;                                 // Removed (cell, value) literals in order
+
+    std::vector<int> nogoods_;
+    std::vector<std::vector<uint32_t>> watches_; // Slots of the nogoods that contain a literal
+    uint64_t nextNogood_{0};
+
+    int64_t nodes_{0};
+    int64_t nogoodHits_{0};
+};
+
+// Runs BackjumpingSudokuSearch on a copy of the puzzle, for chronological backtracking with backjumping disabled
+class BackjumpingSudokuSolver
+{
+public:
+    BackjumpingSudokuSolver(bool backjumping, size_t nogoodCapacity = 0)
+        : backjumping_(backjumping)
+        , nogoodCapacity_(nogoodCapacity)
+    {
+    }
+
+    // Optionally adds the number of placed values to nodes
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku,
+                                                    int64_t* nodes = nullptr) const
+    {
+        auto search = std::make_unique<BackjumpingSudokuSearch<SudokuDimension>>(sudoku, backjumping_, nogoodCapacity_);
+        const bool solved = search->solve();
+        if (nodes)
+        {
+            *nodes += search->nodes();
+        }
+        return solved ? std::make_shared<SudokuMap<SudokuDimension>>(search->board()) : nullptr;
+    }
+
+private:
+    const bool backjumping_{true};
+    const size_t nogoodCapacity_{0};
+};
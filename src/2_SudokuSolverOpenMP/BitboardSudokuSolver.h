@@ -0,0 +1,284 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+
+// Solver for classic 9x9 boards on the bitboards of SudokuMap<9>. The state of the search is one bitboard per value
+// with the cells that may still hold it, where a solved cell keeps only the bit of its value. Propagation counts the
+// candidates of all cells at once with bit sliced adders over the nine boards to find naked singles, and looks for
+// hidden singles per value in the rows, columns and subgrids of all bands at once. The search branches on a cell with
+// two candidates if there is one, copying the state instead of undoing it.
+class BitboardSudokuSolver
+{
+public:
+    std::shared_ptr<SudokuMap<9>> run(const SudokuMap<9>& sudoku) const
+    {
+        auto state = State();
+        if (!start(state, sudoku) || !solve(state))
+        {
+            return nullptr;
+        }
+
+        auto solution = std::make_shared<SudokuMap<9>>(sudoku);
+        for (int value = 0; value < 9; value++)
+        {
+            for (auto board = state.candidates[value]; board != 0; board &= board - 1)
+            {
+                const int cell = SudokuMap<9>::cellOf(lowestBit(board));
+                solution->setElem(cell % 9, cell / 9, value + 1);
+            }
+        }
+        return solution;
+    }
+
+    // Number of solutions, counting stops at the limit
+    int64_t countSolutions(const SudokuMap<9>& sudoku, int64_t limit = 2) const
+    {
+        auto state = State();
+        return start(state, sudoku) ? count(state, limit) : 0;
+    }
+
+private:
+    using Bitboard = SudokuMap<9>::Bitboard;
+
+    static constexpr Bitboard allCells = [] {
+        Bitboard board = 0;
+        for (int cell = 0; cell < SudokuMap<9>::numOfCells; cell++)
+        {
+            board |= SudokuMap<9>::bitOf(cell);
+        }
+        return board;
+    }();
+
+    // One 32 bit lane per band
+    using Lanes = uint32_t __attribute__((vector_size(16)));
+
+    struct State
+    {
+        std::array<Bitboard, 9> candidates{allCells, allCells, allCells, allCells, allCells,
+                                           allCells, allCells, allCells, allCells};
+        Bitboard unsolved{allCells};
+    };
+
+    static int lowestBit(Bitboard board)
+    {
+        const auto low = static_cast<uint64_t>(board);
+        return low != 0 ? std::countr_zero(low) : 64 + std::countr_zero(static_cast<uint64_t>(board >> 64));
+    }
+
+    static bool start(State& state, const SudokuMap<9>& sudoku)
+    {
+        for (int cell = 0; cell < SudokuMap<9>::numOfCells; cell++)
+        {
+            const int value = sudoku.getElem(cell % 9, cell / 9);
+            if (value != 0 && !place(state, cell, value - 1))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Cells that are the only candidate of a value in their row, column or subgrid. Rows and subgrids are 9 bits of a
+    // band, so they are checked for all bands at once, columns are folded over the rows of the bands. Returns false if
+    // the value has no candidate left in a row, column or subgrid.
+    static bool findHiddenSingles(Bitboard candidates, Bitboard& hiddenSingles)
+    {
+        const auto bands = std::bit_cast<Lanes>(candidates);
+        Lanes singles = {};
+        for (const uint32_t house : {0x1FFu, 0x1FFu << 9, 0x1FFu << 18, 0x1C0E07u, 0x1C0E07u << 3, 0x1C0E07u << 6})
+        {
+            const Lanes cells = bands & house;
+            const auto empty = cells == 0;
+            if (empty[0] | empty[1] | empty[2])
+            {
+                return false;
+            }
+            singles |= cells & reinterpret_cast<Lanes>((cells & (cells - 1)) == 0);
+        }
+
+        uint32_t atLeastOne = 0;
+        uint32_t atLeastTwo = 0;
+        for (int band = 0; band < 3; band++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                const uint32_t columns = (bands[band] >> (9 * row)) & 0x1FF;
+                atLeastTwo |= atLeastOne & columns;
+                atLeastOne |= columns;
+            }
+        }
+        if (atLeastOne != 0x1FF)
+        {
+            return false;
+        }
+        const uint32_t columns = atLeastOne & ~atLeastTwo;
+        singles |= bands & (columns | columns << 9 | columns << 18);
+
+        hiddenSingles = std::bit_cast<Bitboard>(singles);
+        return true;
+    }
+
+    // Returns false if the value is no candidate of the cell any more
+    static bool place(State& state, int cell, int value)
+    {
+        const Bitboard bit = SudokuMap<9>::bitOf(cell);
+        if ((state.candidates[value] & bit) == 0)
+        {
+            return false;
+        }
+
+        for (auto& candidates : state.candidates)
+        {
+            candidates &= ~bit;
+        }
+        state.candidates[value] &= ~SudokuMap<9>::units()[cell];
+        state.candidates[value] |= bit;
+        state.unsolved &= ~bit;
+        return true;
+    }
+
+    // Places singles until there are none left, returns false on a contradiction
+    static bool propagate(State& state)
+    {
+        while (state.unsolved != 0)
+        {
+            // Cells with at least one and at least two candidates
+            Bitboard ones = 0;
+            Bitboard twos = 0;
+            for (const auto candidates : state.candidates)
+            {
+                twos |= ones & candidates;
+                ones |= candidates;
+            }
+            if ((state.unsolved & ~ones) != 0)
+            {
+                return false;
+            }
+
+            if (Bitboard nakedSingles = state.unsolved & ~twos)
+            {
+                for (; nakedSingles != 0; nakedSingles &= nakedSingles - 1)
+                {
+                    const int bit = lowestBit(nakedSingles);
+                    const Bitboard cellBit = Bitboard{1} << bit;
+                    int value = 0;
+                    while (value < 9 && (state.candidates[value] & cellBit) == 0)
+                    {
+                        value++;
+                    }
+                    if (value == 9 || !place(state, SudokuMap<9>::cellOf(bit), value))
+                    {
+                        return false;
+                    }
+                }
+                continue;
+            }
+
+            bool placed = false;
+            for (int value = 0; value < 9; value++)
+            {
+                if ((state.candidates[value] & state.unsolved) == 0)
+                {
+                    continue;
+                }
+
+                Bitboard hiddenSingles = 0;
+                if (!findHiddenSingles(state.candidates[value], hiddenSingles))
+                {
+                    return false;
+                }
+                for (hiddenSingles &= state.unsolved; hiddenSingles != 0; hiddenSingles &= hiddenSingles - 1)
+                {
+                    if (!place(state, SudokuMap<9>::cellOf(lowestBit(hiddenSingles)), value))
+                    {
+                        return false;
+                    }
+                    placed = true;
+                }
+            }
+            if (!placed)
+            {
+                return true;
+            }
+        }
+        return true;
+    }
+
+    // Cell to branch on, preferably one with exactly two candidates
+    static int branchBit(const State& state)
+    {
+        Bitboard ones = 0;
+        Bitboard twos = 0;
+        Bitboard threes = 0;
+        for (const auto candidates : state.candidates)
+        {
+            threes |= twos & candidates;
+            twos |= ones & candidates;
+            ones |= candidates;
+        }
+        const Bitboard pairs = state.unsolved & twos & ~threes;
+        return lowestBit(pairs != 0 ? pairs : state.unsolved);
+    }
+
+    static bool solve(State& state)
+    {
+        if (!propagate(state))
+        {
+            return false;
+        }
+        if (state.unsolved == 0)
+        {
+            return true;
+        }
+
+        const int bit = branchBit(state);
+        const Bitboard cellBit = Bitboard{1} << bit;
+        for (int value = 0; value < 9; value++)
+        {
+            if ((state.candidates[value] & cellBit) == 0)
+            {
+                continue;
+            }
+
+            auto next = state;
+            place(next, SudokuMap<9>::cellOf(bit), value);
+            if (solve(next))
+            {
+                state = next;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static int64_t count(State& state, int64_t limit)
+    {
+        if (!propagate(state))
+        {
+            return 0;
+        }
+        if (state.unsolved == 0)
+        {
+            return 1;
+        }
+
+        int64_t numOfSolutions = 0;
+        const int bit = branchBit(state);
+        const Bitboard cellBit = Bitboard{1} << bit;
+        for (int value = 0; value < 9 && numOfSolutions < limit; value++)
+        {
+            if ((state.candidates[value] & cellBit) != 0)
+            {
+                auto next = state;
+                place(next, SudokuMap<9>::cellOf(bit), value);
+                numOfSolutions += count(next, limit - numOfSolutions);
+            }
+        }
+        return numOfSolutions;
+    }
+};
@@ -0,0 +1,262 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <omp.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Partial boards stored back to back with one byte per cell
+template <int SudokuDimension>
+class SudokuFrontier
+{
+public:
+    static constexpr size_t numOfCells = SudokuDimension * SudokuDimension;
+
+    size_t size() const
+    {
+        return cells_.size() / numOfCells;
+    }
+
+    bool empty() const
+    {
+        return cells_.empty();
+    }
+
+    void push(const SudokuMap<SudokuDimension>& sudoku)
+    {
+        for (size_t y = 0; y < SudokuDimension; y++)
+        {
+            for (size_t x = 0; x < SudokuDimension; x++)
+            {
+                cells_.push_back(static_cast<uint8_t>(sudoku.getElem(x, y)));
+            }
+        }
+    }
+
+    void get(size_t index, SudokuMap<SudokuDimension>& sudoku) const
+    {
+        const auto* cells = cells_.data() + index * numOfCells;
+        for (size_t y = 0; y < SudokuDimension; y++)
+        {
+            for (size_t x = 0; x < SudokuDimension; x++)
+            {
+                sudoku.setElem(x, y, cells[x + y * SudokuDimension]);
+            }
+        }
+    }
+
+    void pop(SudokuMap<SudokuDimension>& sudoku)
+    {
+        get(size() - 1, sudoku);
+        cells_.resize(cells_.size() - numOfCells);
+    }
+
+private:
+    std::vector<uint8_t> cells_;
+};
+
+// Expands the search tree breadth first in raster order until the frontier holds at least frontierFactor partial
+// boards per thread, then lets the threads of an OpenMP team take boards from the frontier and search them depth
+// first. As long as threads are waiting for work, busy threads split off their untried candidates into the frontier.
+class FrontierSudokuSolver
+{
+public:
+    FrontierSudokuSolver(int numOfThreads, int frontierFactor)
+        : numOfThreads_(numOfThreads)
+        , frontierFactor_(frontierFactor)
+    {
+    }
+
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku) const
+    {
+        auto search = Search<SudokuDimension>();
+        if (auto solution = search.expand(sudoku, static_cast<size_t>(frontierFactor_) * numOfThreads_))
+        {
+            return solution;
+        }
+
+#pragma omp parallel num_threads(numOfThreads_)
+        {
+            auto board = sudoku;
+            const int teamSize = omp_get_num_threads();
+            while (search.take(board, teamSize))
+            {
+                if (search.solve(board, 0))
+                {
+                    search.publish(board);
+                }
+            }
+        }
+
+        return search.solution();
+    }
+
+private:
+    template <int SudokuDimension>
+    class Search
+    {
+    public:
+        // Breadth first expansion of the start board, returns the solution if it was already reached
+        std::shared_ptr<SudokuMap<SudokuDimension>> expand(const SudokuMap<SudokuDimension>& sudoku, size_t minSize)
+        {
+            frontier_.push(sudoku);
+            auto board = sudoku;
+            while (!frontier_.empty() && frontier_.size() < minSize)
+            {
+                auto next = SudokuFrontier<SudokuDimension>();
+                for (size_t i = 0; i < frontier_.size(); i++)
+                {
+                    frontier_.get(i, board);
+                    const int index = firstEmpty(board, 0);
+                    if (index == numOfCells)
+                    {
+                        return std::make_shared<SudokuMap<SudokuDimension>>(board);
+                    }
+
+                    const int x = index % SudokuDimension;
+                    const int y = index / SudokuDimension;
+                    for (int value = 1; value <= SudokuDimension; value++)
+                    {
+                        if (board.isCandidate(x, y, value))
+                        {
+                            board.setElem(x, y, value);
+                            next.push(board);
+                        }
+                    }
+                }
+                frontier_ = std::move(next);
+            }
+
+            return nullptr;
+        }
+
+        // Waits for the next board, returns false once the search is over. The search is over without a solution once
+        // all threads of the team wait, which may be fewer than requested.
+        bool take(SudokuMap<SudokuDimension>& board, int teamSize)
+        {
+            auto lock = std::unique_lock(mutex_);
+            teamSize_ = teamSize;
+            idleThreads_++;
+            while (!done_ && frontier_.empty())
+            {
+                if (idleThreads_ == teamSize_)
+                {
+                    // Nobody is left to split off work
+                    done_ = true;
+                    available_.notify_all();
+                    break;
+                }
+                available_.wait(lock);
+            }
+
+            if (done_)
+            {
+                return false;
+            }
+
+            idleThreads_--;
+            frontier_.pop(board);
+            return true;
+        }
+
+        // Depth first search in place from the given cell on
+        bool solve(SudokuMap<SudokuDimension>& board, int index)
+        {
+            index = firstEmpty(board, index);
+            if (index == numOfCells)
+            {
+                return true;
+            }
+            if (done_.load(std::memory_order_relaxed))
+            {
+                return false;
+            }
+
+            const int x = index % SudokuDimension;
+            const int y = index / SudokuDimension;
+
+            int candidates[SudokuDimension];
+            int numOfCandidates = 0;
+            for (int value = 1; value <= SudokuDimension; value++)
+            {
+                if (board.isCandidate(x, y, value))
+                {
+                    candidates[numOfCandidates++] = value;
+                }
+            }
+
+            for (int i = 0; i < numOfCandidates; i++)
+            {
+                board.setElem(x, y, candidates[i]);
+
+                // Keep the last candidate, every other one goes to a waiting thread
+                if (i + 1 < numOfCandidates && idleThreads_.load(std::memory_order_relaxed) > 0)
+                {
+                    share(board);
+                    continue;
+                }
+
+                if (solve(board, index + 1))
+                {
+                    return true;
+                }
+            }
+
+            board.setElem(x, y, 0);
+            return false;
+        }
+
+        void publish(const SudokuMap<SudokuDimension>& board)
+        {
+            const auto lock = std::lock_guard(mutex_);
+            if (!solution_)
+            {
+                solution_ = std::make_shared<SudokuMap<SudokuDimension>>(board);
+            }
+            done_ = true;
+            available_.notify_all();
+        }
+
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution() const
+        {
+            return solution_;
+        }
+
+    private:
+        static constexpr int numOfCells = SudokuDimension * SudokuDimension;
+
+        static int firstEmpty(const SudokuMap<SudokuDimension>& board, int index)
+        {
+            while (index < numOfCells && board.getElem(index % SudokuDimension, index / SudokuDimension) != 0)
+            {
+                index++;
+            }
+            return index;
+        }
+
+        void share(const SudokuMap<SudokuDimension>& board)
+        {
+            const auto lock = std::lock_guard(mutex_);
+            frontier_.push(board);
+            available_.notify_one();
+        }
+
+        int teamSize_{0};
+        SudokuFrontier<SudokuDimension> frontier_;
+        std::mutex mutex_;
+        std::condition_variable available_;
+        std::atomic<int> idleThreads_{0};
+        std::atomic<bool> done_{false};
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution_;
+    };
+
+    const int numOfThreads_{1};
+    const int frontierFactor_{1};
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "SudokuMap.h"
+#include "SudokuSearch.h"
+
+#include <cstdint>
+#include <optional>
+
+// Keeps the solution of a puzzle across single clue edits. Removing a clue never invalidates the solution, and neither
+// does adding the value the solution already has. Otherwise only the cells that share a row, column or subgrid with the
+// edited cell are cleared and searched again around the rest of the old solution, then if that fails all cells in the
+// band and stack of the edited cell. Only if both repairs fail within maxRepairNodes each, the puzzle is solved again
+// from its clues.
+template <int SudokuDimension>
+class IncrementalSudokuSolver
+{
+public:
+    // How an edit was answered
+    enum class Answer
+    {
+        Kept,
+        Repaired,
+        Resolved,
+        Unsolvable,
+    };
+
+    explicit IncrementalSudokuSolver(SudokuStrategy strategy, int64_t maxRepairNodes = 1000)
+        : strategy_(strategy)
+        , maxRepairNodes_(maxRepairNodes)
+    {
+    }
+
+    // Solves the puzzle from scratch
+    Answer reset(const SudokuMap<SudokuDimension>& puzzle)
+    {
+        puzzle_ = puzzle;
+        return resolve();
+    }
+
+    // Sets the clue of the cell to the value, or removes it for 0
+    Answer setClue(int x, int y, int value)
+    {
+        const int previous = puzzle_.getElem(x, y);
+        puzzle_.setElem(x, y, 0);
+        if (value == 0)
+        {
+            return solution_ ? Answer::Kept : resolve();
+        }
+
+        const bool allowed = puzzle_.isCandidate(x, y, value);
+        puzzle_.setElem(x, y, value);
+        if (!allowed)
+        {
+            solution_.reset();
+            return Answer::Unsolvable;
+        }
+
+        // A changed clue may have been the reason there was no solution
+        if (!solution_)
+        {
+            return previous != 0 ? resolve() : Answer::Unsolvable;
+        }
+        if (solution_->getElem(x, y) == value)
+        {
+            return Answer::Kept;
+        }
+
+        // First only the row, column and subgrid of the cell, then its whole band and stack
+        const int band = y / subgridSize() * subgridSize();
+        const int stack = x / subgridSize() * subgridSize();
+        if (repair(x, y, y, y, x, x) || repair(x, y, band, band + subgridSize() - 1, stack, stack + subgridSize() - 1))
+        {
+            return Answer::Repaired;
+        }
+        return resolve();
+    }
+
+    const SudokuMap<SudokuDimension>& puzzle() const
+    {
+        return puzzle_;
+    }
+
+    // Solution of the current clues, if there is one
+    const std::optional<SudokuMap<SudokuDimension>>& solution() const
+    {
+        return solution_;
+    }
+
+private:
+    static constexpr int subgridSize()
+    {
+        int size = 1;
+        while (size * size < SudokuDimension)
+        {
+            size++;
+        }
+        return size;
+    }
+
+    // Searches the cells that are no clues again within the given rows and columns, and within the subgrid of the
+    // cell, with every other cell fixed to the old solution
+    bool repair(int x, int y, int firstRow, int lastRow, int firstColumn, int lastColumn)
+    {
+        auto board = *solution_;
+        for (int i = 0; i < SudokuDimension; i++)
+        {
+            for (int row = firstRow; row <= lastRow; row++)
+            {
+                board.setElem(i, row, puzzle_.getElem(i, row));
+            }
+            for (int column = firstColumn; column <= lastColumn; column++)
+            {
+                board.setElem(column, i, puzzle_.getElem(column, i));
+            }
+
+            const int peerX = x / subgridSize() * subgridSize() + i % subgridSize();
+            const int peerY = y / subgridSize() * subgridSize() + i / subgridSize();
+            board.setElem(peerX, peerY, puzzle_.getElem(peerX, peerY));
+        }
+
+        auto search = SudokuSearch<SudokuDimension>(board, strategy_);
+        if (!search.solve(maxRepairNodes_))
+        {
+            return false;
+        }
+        solution_ = search.board();
+        return true;
+    }
+
+    Answer resolve()
+    {
+        auto search = SudokuSearch<SudokuDimension>(puzzle_, strategy_);
+        if (!search.solve())
+        {
+            solution_.reset();
+            return Answer::Unsolvable;
+        }
+        solution_ = search.board();
+        return Answer::Resolved;
+    }
+
+    const SudokuStrategy strategy_;
+    const int64_t maxRepairNodes_;
+    SudokuMap<SudokuDimension> puzzle_{std::vector<int>(SudokuDimension * SudokuDimension)};
+    std::optional<SudokuMap<SudokuDimension>> solution_;
+};
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "Common/LatencyHistogram.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Open loop load generator: sends requests at fixed intervals for the given rate, no matter how many are still in
+// flight, like independent clients would. The latency of a request counts from the time it was scheduled to be sent,
+// so a generator that falls behind does not hide the queueing delay it caused (coordinated omission).
+class OpenLoopLoad
+{
+public:
+    explicit OpenLoopLoad(double requestsPerSecond)
+        : interval_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(1.0 / requestsPerSecond)))
+    {
+    }
+
+    // Sends numOfRequests puzzles round robin to the service and waits for all answers, returns the number of
+    // requests without a solution
+    template <typename Service, typename Puzzle>
+    int64_t run(Service& service, const std::vector<Puzzle>& puzzles, int64_t numOfRequests,
+                LatencyHistogram& latencies) const
+    {
+        std::mutex mutex;
+        std::condition_variable answered;
+        int64_t numOfAnswers = 0;
+        int64_t numOfFailures = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int64_t i = 0; i < numOfRequests; i++)
+        {
+            const auto scheduled = start + i * interval_;
+            std::this_thread::sleep_until(scheduled);
+
+            service.submit(puzzles[i % puzzles.size()], [&, scheduled](const auto& solution) {
+                const auto latency = std::chrono::steady_clock::now() - scheduled;
+                const auto lock = std::lock_guard(mutex);
+                latencies.record(latency);
+                numOfFailures += solution ? 0 : 1;
+                if (++numOfAnswers == numOfRequests)
+                {
+                    answered.notify_one();
+                }
+            });
+        }
+
+        auto lock = std::unique_lock(mutex);
+        answered.wait(lock, [&] { return numOfAnswers == numOfRequests; });
+        return numOfFailures;
+    }
+
+private:
+    const std::chrono::steady_clock::duration interval_;
+};
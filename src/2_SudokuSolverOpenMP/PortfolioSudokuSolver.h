@@ -0,0 +1,89 @@
+#pragma once
+
+#include "SudokuMap.h"
+#include "SudokuSearch.h"
+
+#include <omp.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Races differently configured sequential searches on the same puzzle, one per thread, and cancels the others as soon
+// as the first one finishes. Threads beyond the number of strategies reuse their cell orders with random value orders
+// and other seeds, as a deterministic search would only repeat what the thread before it does.
+class PortfolioSudokuSolver
+{
+public:
+    PortfolioSudokuSolver(int numOfThreads, std::vector<SudokuStrategy> strategies = defaultStrategies())
+        : numOfThreads_(numOfThreads)
+        , strategies_(std::move(strategies))
+    {
+    }
+
+    // Strategies in the order threads get them, so that small teams already mix cell and value orders
+    static std::vector<SudokuStrategy> defaultStrategies()
+    {
+        using CellOrder = SudokuStrategy::CellOrder;
+        using ValueOrder = SudokuStrategy::ValueOrder;
+        return {
+            {CellOrder::Raster, ValueOrder::Ascending},
+            {CellOrder::MinimumRemainingValues, ValueOrder::Ascending},
+            {CellOrder::MinimumRemainingValues, ValueOrder::Random, 1},
+            {CellOrder::Raster, ValueOrder::Descending},
+            {CellOrder::MinimumRemainingValues, ValueOrder::Random, 2},
+            {CellOrder::Raster, ValueOrder::Random, 1},
+            {CellOrder::MinimumRemainingValues, ValueOrder::Descending},
+            {CellOrder::Raster, ValueOrder::Random, 2},
+        };
+    }
+
+    SudokuStrategy strategyOfThread(int thread) const
+    {
+        const size_t index = thread % strategies_.size();
+        const auto round = static_cast<uint64_t>(thread / strategies_.size());
+        auto strategy = strategies_.at(index);
+        if (round == 0)
+        {
+            return strategy;
+        }
+
+        // Deterministic entries get seeds of their own, apart from those of the random ones
+        if (strategy.valueOrder != SudokuStrategy::ValueOrder::Random)
+        {
+            strategy.valueOrder = SudokuStrategy::ValueOrder::Random;
+            strategy.seed = 500 + index;
+        }
+        strategy.seed += round * 1000;
+        return strategy;
+    }
+
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku) const
+    {
+        std::atomic<bool> done{false};
+        std::mutex mutex;
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution;
+
+#pragma omp parallel num_threads(numOfThreads_)
+        {
+            auto search = SudokuSearch<SudokuDimension>(sudoku, strategyOfThread(omp_get_thread_num()), &done);
+            if (search.solve())
+            {
+                const auto lock = std::lock_guard(mutex);
+                if (!solution)
+                {
+                    solution = std::make_shared<SudokuMap<SudokuDimension>>(search.board());
+                }
+                done = true;
+            }
+        }
+
+        return solution;
+    }
+
+private:
+    const int numOfThreads_{1};
+    const std::vector<SudokuStrategy> strategies_;
+};
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "SudokuMap.h"
+#include "SudokuSearch.h"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+
+// Node cutoffs for the attempts of a restarting search: a constant unit times the Luby sequence 1 1 2 1 1 2 4 1 1 2 ...,
+// or growing geometrically by a factor per restart, or no restarts at all
+class RestartPolicy
+{
+public:
+    enum class Schedule
+    {
+        None,
+        Luby,
+        Geometric,
+    };
+
+    RestartPolicy(Schedule schedule, int64_t unitNodes, double growth = 1.5)
+        : schedule_(schedule)
+        , unitNodes_(unitNodes)
+        , growth_(growth)
+    {
+    }
+
+    int64_t cutoff(int64_t restart) const
+    {
+        switch (schedule_)
+        {
+        case Schedule::None:
+            break;
+        case Schedule::Luby:
+            return unitNodes_ * luby(restart + 1);
+        case Schedule::Geometric:
+        {
+            // Beyond the range of int64_t the cast would be undefined, which takes about 90 restarts at 1.5
+            const double nodes = static_cast<double>(unitNodes_) * std::pow(growth_, static_cast<double>(restart));
+            if (nodes < static_cast<double>(std::numeric_limits<int64_t>::max()))
+            {
+                return static_cast<int64_t>(nodes);
+            }
+            break;
+        }
+        }
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    std::string name() const
+    {
+        switch (schedule_)
+        {
+        case Schedule::None:
+            return "none";
+        case Schedule::Luby:
+            return "luby:" + std::to_string(unitNodes_);
+        case Schedule::Geometric:
+            return "geometric:" + std::to_string(unitNodes_);
+        }
+        return "";
+    }
+
+    // i-th element of the Luby sequence, starting at i = 1
+    static int64_t luby(int64_t i)
+    {
+        // Find the smallest k with 2^k - 1 >= i, the sequence ends with 2^(k-1) there and repeats itself before
+        int k = 1;
+        while ((int64_t{1} << k) - 1 < i)
+        {
+            k++;
+        }
+        if ((int64_t{1} << k) - 1 == i)
+        {
+            return int64_t{1} << (k - 1);
+        }
+        return luby(i - (int64_t{1} << (k - 1)) + 1);
+    }
+
+private:
+    const Schedule schedule_;
+    const int64_t unitNodes_;
+    const double growth_;
+};
+
+// Restarts a randomized sequential search with a fresh seed whenever it exceeds the node cutoff of the policy, which
+// cuts off the heavy tail of unlucky first choices. Every puzzle is solved with the same seeds, from the given one on.
+class RestartingSudokuSolver
+{
+public:
+    RestartingSudokuSolver(RestartPolicy policy, SudokuStrategy strategy, uint64_t seed)
+        : policy_(policy)
+        , strategy_(strategy)
+        , seed_(seed)
+    {
+    }
+
+    // Optionally returns the number of restarts and of nodes over all attempts
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku,
+                                                    int64_t* restarts = nullptr, int64_t* nodes = nullptr) const
+    {
+        auto random = std::mt19937_64(seed_);
+        auto strategy = strategy_;
+        int64_t totalNodes = 0;
+
+        for (int64_t restart = 0;; restart++)
+        {
+            strategy.seed = random();
+            auto search = SudokuSearch<SudokuDimension>(sudoku, strategy);
+            const bool solved = search.solve(policy_.cutoff(restart));
+            totalNodes += search.nodes();
+
+            if (solved || !search.interrupted())
+            {
+                if (restarts)
+                {
+                    *restarts = restart;
+                }
+                if (nodes)
+                {
+                    *nodes = totalNodes;
+                }
+                return solved ? std::make_shared<SudokuMap<SudokuDimension>>(search.board()) : nullptr;
+            }
+        }
+    }
+
+private:
+    const RestartPolicy policy_;
+    const SudokuStrategy strategy_;
+    const uint64_t seed_;
+};
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "SudokuMap.h"
+#include "SudokuSearch.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Single strategy counterpart of PortfolioSudokuSolver: expands the first empty cells in raster order breadth first
+// into at least frontierFactor boards per thread, and searches them with one strategy on a dynamically scheduled
+// OpenMP loop until the first solution is found.
+class SplitSudokuSolver
+{
+public:
+    SplitSudokuSolver(int numOfThreads, SudokuStrategy strategy = {}, int frontierFactor = 4)
+        : numOfThreads_(numOfThreads)
+        , strategy_(strategy)
+        , frontierFactor_(frontierFactor)
+    {
+    }
+
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku) const
+    {
+        const auto boards = expand(sudoku, static_cast<size_t>(frontierFactor_) * numOfThreads_);
+        const auto numOfBoards = static_cast<int>(boards.size());
+
+        std::atomic<bool> done{false};
+        std::mutex mutex;
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution;
+
+#pragma omp parallel for schedule(dynamic, 1) num_threads(numOfThreads_)
+        for (int i = 0; i < numOfBoards; i++)
+        {
+            if (done.load(std::memory_order_relaxed))
+            {
+                continue;
+            }
+
+            auto search = SudokuSearch<SudokuDimension>(boards[i], strategy_, &done);
+            if (search.solve())
+            {
+                const auto lock = std::lock_guard(mutex);
+                if (!solution)
+                {
+                    solution = std::make_shared<SudokuMap<SudokuDimension>>(search.board());
+                }
+                done = true;
+            }
+        }
+
+        return solution;
+    }
+
+private:
+    template <int SudokuDimension>
+    static std::vector<SudokuMap<SudokuDimension>> expand(const SudokuMap<SudokuDimension>& sudoku, size_t minSize)
+    {
+        auto boards = std::vector<SudokuMap<SudokuDimension>>{sudoku};
+        for (int cell = 0; cell < SudokuDimension * SudokuDimension && boards.size() < minSize; cell++)
+        {
+            const int x = cell % SudokuDimension;
+            const int y = cell / SudokuDimension;
+            if (sudoku.getElem(x, y) != 0)
+            {
+                continue;
+            }
+
+            auto next = std::vector<SudokuMap<SudokuDimension>>();
+            for (auto& board : boards)
+            {
+                for (int value = 1; value <= SudokuDimension; value++)
+                {
+                    if (board.isCandidate(x, y, value))
+                    {
+                        board.setElem(x, y, value);
+                        next.push_back(board);
+                    }
+                }
+            }
+            if (next.empty())
+            {
+                // No solution, let the search find that out on the unexpanded board
+                break;
+            }
+            boards = std::move(next);
+        }
+        return boards;
+    }
+
+    const int numOfThreads_{1};
+    const SudokuStrategy strategy_;
+    const int frontierFactor_{4};
+};
@@ -0,0 +1,269 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Iterative depth first search in raster order over an explicit, preallocated stack of (cell, value) frames per thread.
+// Only the first thread starts with work. Idle threads steal the untried values of the oldest frame of a busy thread,
+// which is the biggest unexplored subtree it has, as long as the frame lies within the first maxStealDepth frames.
+class StackSudokuSolver
+{
+public:
+    StackSudokuSolver(int numOfThreads, int maxStealDepth)
+        : numOfThreads_(numOfThreads)
+        , maxStealDepth_(maxStealDepth)
+    {
+    }
+
+    // Optionally returns the seconds every thread spent without work
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(const SudokuMap<SudokuDimension>& sudoku,
+                                                    std::vector<double>* idleSeconds = nullptr) const
+    {
+        auto search = Search<SudokuDimension>(sudoku, numOfThreads_, maxStealDepth_);
+
+#pragma omp parallel num_threads(numOfThreads_)
+        {
+            search.work(omp_get_thread_num());
+        }
+
+        if (idleSeconds)
+        {
+            *idleSeconds = search.idleSeconds();
+        }
+        return search.solution();
+    }
+
+private:
+    template <int SudokuDimension>
+    class Search
+    {
+    public:
+        Search(const SudokuMap<SudokuDimension>& sudoku, int numOfThreads, int maxStealDepth)
+            : maxStealDepth_(maxStealDepth)
+            , workers_(numOfThreads)
+        {
+            for (auto& worker : workers_)
+            {
+                worker.board = std::make_unique<SudokuMap<SudokuDimension>>(sudoku);
+                worker.frames.resize(numOfCells);
+            }
+
+            // The first thread starts at the first empty cell, all others have to steal
+            const int cell = nextEmpty(sudoku, 0);
+            if (cell == numOfCells)
+            {
+                solution_ = std::make_shared<SudokuMap<SudokuDimension>>(sudoku);
+                done_ = true;
+                return;
+            }
+            workers_.front().frames.front() = Frame{cell, 0};
+            workers_.front().depth = 1;
+            activeWorkers_ = 1;
+        }
+
+        void work(int index)
+        {
+            auto& worker = workers_.at(index);
+            auto idleSince = std::chrono::steady_clock::now();
+            bool idle = worker.depth == 0;
+
+            while (!done_.load(std::memory_order_relaxed))
+            {
+                if (idle)
+                {
+                    if (activeWorkers_.load() == 0)
+                    {
+                        break;
+                    }
+                    if (!steal(index))
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    worker.idle += std::chrono::steady_clock::now() - idleSince;
+                    idle = false;
+                }
+
+                if (!step(worker))
+                {
+                    activeWorkers_--;
+                    idleSince = std::chrono::steady_clock::now();
+                    idle = true;
+                }
+            }
+
+            if (idle)
+            {
+                worker.idle += std::chrono::steady_clock::now() - idleSince;
+            }
+        }
+
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution() const
+        {
+            return solution_;
+        }
+
+        std::vector<double> idleSeconds() const
+        {
+            auto seconds = std::vector<double>();
+            for (const auto& worker : workers_)
+            {
+                seconds.push_back(std::chrono::duration<double>(worker.idle).count());
+            }
+            return seconds;
+        }
+
+    private:
+        static constexpr int numOfCells = SudokuDimension * SudokuDimension;
+
+        struct Frame
+        {
+            int cell;
+            int value; // Currently placed value, the next one to try is the next candidate above it
+        };
+
+        struct Worker
+        {
+            std::unique_ptr<SudokuMap<SudokuDimension>> board;
+            std::vector<Frame> frames;
+            int depth{0};
+            std::mutex mutex; // Guards board, frames and depth against thieves
+            std::chrono::steady_clock::duration idle{};
+        };
+
+        static int nextEmpty(const SudokuMap<SudokuDimension>& board, int cell)
+        {
+            while (cell < numOfCells && board.getElem(cell % SudokuDimension, cell / SudokuDimension) != 0)
+            {
+                cell++;
+            }
+            return cell;
+        }
+
+        static int nextCandidate(const SudokuMap<SudokuDimension>& board, const Frame& frame)
+        {
+            const int x = frame.cell % SudokuDimension;
+            const int y = frame.cell / SudokuDimension;
+            for (int value = frame.value + 1; value <= SudokuDimension; value++)
+            {
+                if (board.isCandidate(x, y, value))
+                {
+                    return value;
+                }
+            }
+            return 0;
+        }
+
+        // Places the next value of the top frame and descends, returns false once the stack ran empty
+        bool step(Worker& worker)
+        {
+            auto& board = *worker.board;
+            auto lock = std::unique_lock(worker.mutex);
+            if (worker.depth == 0)
+            {
+                return false;
+            }
+
+            auto& frame = worker.frames[worker.depth - 1];
+            const int x = frame.cell % SudokuDimension;
+            const int y = frame.cell / SudokuDimension;
+            board.setElem(x, y, 0);
+            const int value = nextCandidate(board, frame);
+            if (value == 0)
+            {
+                worker.depth--;
+                return worker.depth > 0;
+            }
+            frame.value = value;
+            board.setElem(x, y, value);
+
+            const int cell = nextEmpty(board, frame.cell + 1);
+            if (cell == numOfCells)
+            {
+                lock.unlock();
+                publish(board);
+                return true;
+            }
+            worker.frames[worker.depth++] = Frame{cell, 0};
+            return true;
+        }
+
+        // Takes the untried values of the oldest frame of another thread that has any
+        bool steal(int thiefIndex)
+        {
+            auto& thief = workers_[thiefIndex];
+            const int numOfWorkers = static_cast<int>(workers_.size());
+            for (int offset = 1; offset < numOfWorkers; offset++)
+            {
+                auto& victim = workers_[(thiefIndex + offset) % numOfWorkers];
+                const auto lock = std::scoped_lock(victim.mutex, thief.mutex);
+                const int maxDepth = std::min(victim.depth, maxStealDepth_);
+                if (maxDepth == 0)
+                {
+                    continue;
+                }
+
+                // Rebuild the board as it was when the frames were entered, one after the other
+                auto& board = *thief.board;
+                board = *victim.board;
+                for (int depth = 0; depth < victim.depth; depth++)
+                {
+                    const int cell = victim.frames[depth].cell;
+                    board.setElem(cell % SudokuDimension, cell / SudokuDimension, 0);
+                }
+
+                for (int depth = 0; depth < maxDepth; depth++)
+                {
+                    auto& frame = victim.frames[depth];
+                    if (nextCandidate(board, frame) != 0)
+                    {
+                        // The thief continues with the values after the current one
+                        thief.frames.front() = frame;
+                        thief.depth = 1;
+                        frame.value = SudokuDimension;
+
+                        // Counted before the victim can finish, so that the number never drops to 0 while work is left
+                        activeWorkers_++;
+                        return true;
+                    }
+
+                    // Nothing left to try here, neither for the thief nor for the victim
+                    frame.value = SudokuDimension;
+                    board.setElem(frame.cell % SudokuDimension, frame.cell / SudokuDimension,
+                                  victim.board->getElem(frame.cell % SudokuDimension, frame.cell / SudokuDimension));
+                }
+            }
+            return false;
+        }
+
+        void publish(const SudokuMap<SudokuDimension>& board)
+        {
+            const auto lock = std::lock_guard(solutionMutex_);
+            if (!solution_)
+            {
+                solution_ = std::make_shared<SudokuMap<SudokuDimension>>(board);
+            }
+            done_ = true;
+        }
+
+        const int maxStealDepth_;
+        std::vector<Worker> workers_;
+        std::atomic<int> activeWorkers_{0};
+        std::atomic<bool> done_{false};
+        std::mutex solutionMutex_;
+        std::shared_ptr<SudokuMap<SudokuDimension>> solution_;
+    };
+
+    const int numOfThreads_{1};
+    const int maxStealDepth_{1};
+};
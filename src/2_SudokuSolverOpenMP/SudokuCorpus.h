@@ -0,0 +1,186 @@
+#pragma once
+
+#include "SudokuMap.h"
+#include "SudokuSearch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Sets the clue of a cell to the value, or removes it for 0
+struct SudokuEdit
+{
+    int x;
+    int y;
+    int value;
+};
+
+// Deterministic puzzle sets derived from a complete board: every puzzle is a random symmetry of the board (relabeled
+// values, permuted rows and columns within their bands and stacks, permuted bands and stacks, optionally transposed)
+// with a random number of cells in [minEmpty, maxEmpty] cleared. The puzzles are solvable, but not necessarily unique.
+template <int SudokuDimension>
+class SudokuCorpus
+{
+public:
+    static std::vector<SudokuMap<SudokuDimension>> generate(const SudokuMap<SudokuDimension>& solution, size_t count,
+                                                            int minEmpty, int maxEmpty, uint64_t seed)
+    {
+        auto random = std::mt19937_64(seed);
+        auto puzzles = std::vector<SudokuMap<SudokuDimension>>();
+        for (size_t i = 0; i < count; i++)
+        {
+            auto puzzle = transform(solution, random);
+
+            auto cells = std::vector<int>(SudokuDimension * SudokuDimension);
+            std::iota(cells.begin(), cells.end(), 0);
+            std::shuffle(cells.begin(), cells.end(), random);
+            const int numOfEmpty = std::uniform_int_distribution<int>(minEmpty, maxEmpty)(random);
+            for (int j = 0; j < numOfEmpty; j++)
+            {
+                puzzle.setElem(cells[j] % SudokuDimension, cells[j] / SudokuDimension, 0);
+            }
+
+            puzzles.push_back(std::move(puzzle));
+        }
+        return puzzles;
+    }
+
+    // Clears the cells of every puzzle in random order as long as it keeps a unique solution, which leaves minimal
+    // puzzles like the published ones. countSolutions(puzzle, limit) has to count the solutions up to the limit.
+    template <typename CountSolutions>
+    static std::vector<SudokuMap<SudokuDimension>> minimize(std::vector<SudokuMap<SudokuDimension>> puzzles,
+                                                            uint64_t seed, CountSolutions countSolutions)
+    {
+        auto random = std::mt19937_64(seed);
+        for (auto& puzzle : puzzles)
+        {
+            auto cells = std::vector<int>(SudokuDimension * SudokuDimension);
+            std::iota(cells.begin(), cells.end(), 0);
+            std::shuffle(cells.begin(), cells.end(), random);
+            for (const int cell : cells)
+            {
+                const int x = cell % SudokuDimension;
+                const int y = cell / SudokuDimension;
+                const int value = puzzle.getElem(x, y);
+                if (value == 0)
+                {
+                    continue;
+                }
+
+                puzzle.setElem(x, y, 0);
+                if (countSolutions(puzzle, 2) != 1)
+                {
+                    puzzle.setElem(x, y, value);
+                }
+            }
+        }
+        return puzzles;
+    }
+
+    // Stream of single clue edits that keeps the puzzle solvable: with the same probability a random clue is removed,
+    // or a random empty cell gets its value in a solution that a search with random value order finds for the clues
+    static std::vector<SudokuEdit> edits(const SudokuMap<SudokuDimension>& puzzle, size_t count, uint64_t seed)
+    {
+        auto random = std::mt19937_64(seed);
+        auto cellDistribution = std::uniform_int_distribution<int>(0, SudokuDimension * SudokuDimension - 1);
+
+        auto strategy = SudokuStrategy();
+        strategy.cellOrder = SudokuStrategy::CellOrder::MinimumRemainingValues;
+        strategy.valueOrder = SudokuStrategy::ValueOrder::Random;
+
+        auto clues = puzzle;
+        auto edits = std::vector<SudokuEdit>();
+        while (edits.size() < count)
+        {
+            const bool remove = std::bernoulli_distribution(0.5)(random);
+            const int cell = cellDistribution(random);
+            const int x = cell % SudokuDimension;
+            const int y = cell / SudokuDimension;
+            if ((clues.getElem(x, y) != 0) != remove)
+            {
+                continue;
+            }
+
+            int value = 0;
+            if (!remove)
+            {
+                strategy.seed = random();
+                auto search = SudokuSearch<SudokuDimension>(clues, strategy);
+                search.solve();
+                value = search.board().getElem(x, y);
+            }
+
+            clues.setElem(x, y, value);
+            edits.push_back(SudokuEdit{x, y, value});
+        }
+        return edits;
+    }
+
+    // Complete board of any dimension from the pattern (size * (y % size) + y / size + x) mod dimension
+    static SudokuMap<SudokuDimension> pattern()
+    {
+        constexpr int size = subgridSize();
+        auto board = SudokuMap<SudokuDimension>(std::vector<int>(SudokuDimension * SudokuDimension));
+        for (int y = 0; y < SudokuDimension; y++)
+        {
+            for (int x = 0; x < SudokuDimension; x++)
+            {
+                board.setElem(x, y, (size * (y % size) + y / size + x) % SudokuDimension + 1);
+            }
+        }
+        return board;
+    }
+
+private:
+    static constexpr int subgridSize()
+    {
+        int size = 1;
+        while (size * size < SudokuDimension)
+        {
+            size++;
+        }
+        return size;
+    }
+
+    // Permutation of the lines of a board that keeps every line within its band
+    static std::vector<int> linePermutation(std::mt19937_64& random)
+    {
+        constexpr int size = subgridSize();
+        auto bands = std::vector<int>(size);
+        std::iota(bands.begin(), bands.end(), 0);
+        std::shuffle(bands.begin(), bands.end(), random);
+
+        auto lines = std::vector<int>();
+        for (const int band : bands)
+        {
+            auto withinBand = std::vector<int>(size);
+            std::iota(withinBand.begin(), withinBand.end(), band * size);
+            std::shuffle(withinBand.begin(), withinBand.end(), random);
+            lines.insert(lines.end(), withinBand.begin(), withinBand.end());
+        }
+        return lines;
+    }
+
+    static SudokuMap<SudokuDimension> transform(const SudokuMap<SudokuDimension>& board, std::mt19937_64& random)
+    {
+        auto values = std::vector<int>(SudokuDimension + 1);
+        std::iota(values.begin(), values.end(), 0);
+        std::shuffle(values.begin() + 1, values.end(), random);
+        const auto rows = linePermutation(random);
+        const auto columns = linePermutation(random);
+        const bool transpose = std::bernoulli_distribution(0.5)(random);
+
+        auto result = board;
+        for (int y = 0; y < SudokuDimension; y++)
+        {
+            for (int x = 0; x < SudokuDimension; x++)
+            {
+                const int value = values[board.getElem(columns[x], rows[y])];
+                result.setElem(transpose ? y : x, transpose ? x : y, value);
+            }
+        }
+        return result;
+    }
+};
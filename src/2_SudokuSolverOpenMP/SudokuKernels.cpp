@@ -0,0 +1,80 @@
+#include "SudokuKernels.h"
+
+// Compiled once per ISA level, see add_isa_variants
+constexpr auto isaLevel = static_cast<IsaLevel>(ISA_LEVEL);
+
+namespace
+{
+template <int SudokuDimension>
+constexpr int subgridSize()
+{
+    int size = 1;
+    while (size * size < SudokuDimension)
+    {
+        ++size;
+    }
+    return size;
+}
+
+// Accumulates instead of returning early, so that the row and column scans can be vectorized
+template <int SudokuDimension>
+bool isCandidate(const int* cells, int x, int y, int value)
+{
+    int conflicts = 0;
+    for (int i = 0; i < SudokuDimension; i++)
+    {
+        conflicts += cells[x + i * SudokuDimension] == value;
+        conflicts += cells[i + y * SudokuDimension] == value;
+    }
+
+    constexpr int size = subgridSize<SudokuDimension>();
+    const int subgridX = (x / size) * size;
+    const int subgridY = (y / size) * size;
+    for (int row = subgridY; row < subgridY + size; row++)
+    {
+        for (int col = subgridX; col < subgridX + size; col++)
+        {
+            conflicts += cells[col + row * SudokuDimension] == value;
+        }
+    }
+
+    return conflicts == 0;
+}
+
+template <int SudokuDimension>
+bool solveFrom(int* cells, int index)
+{
+    constexpr int numOfCells = SudokuDimension * SudokuDimension;
+    while (index < numOfCells && cells[index] != 0)
+    {
+        ++index;
+    }
+    if (index == numOfCells)
+    {
+        return true;
+    }
+
+    const int x = index % SudokuDimension;
+    const int y = index / SudokuDimension;
+    for (int value = 1; value <= SudokuDimension; value++)
+    {
+        if (isCandidate<SudokuDimension>(cells, x, y, value))
+        {
+            cells[index] = value;
+            if (solveFrom<SudokuDimension>(cells, index + 1))
+            {
+                return true;
+            }
+        }
+    }
+
+    cells[index] = 0;
+    return false;
+}
+} // namespace
+
+template <>
+bool SudokuKernels<16, isaLevel>::solve(int* cells)
+{
+    return solveFrom<16>(cells, 0);
+}
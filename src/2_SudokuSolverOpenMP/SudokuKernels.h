@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Common/IsaLevel.h"
+
+#include <stdexcept>
+
+// Single threaded backtracking over the raw cells of a sudoku, row by row, compiled once per ISA level by
+// add_isa_variants. The cells are solved in place, returns false if there is no solution.
+template <int SudokuDimension, IsaLevel Level>
+class SudokuKernels
+{
+public:
+    static bool solve(int* cells);
+};
+
+// Defined by the variant of each level, see add_isa_variants
+template <>
+bool SudokuKernels<16, IsaLevel::Baseline>::solve(int* cells);
+template <>
+bool SudokuKernels<16, IsaLevel::X86_64_V2>::solve(int* cells);
+template <>
+bool SudokuKernels<16, IsaLevel::X86_64_V3>::solve(int* cells);
+template <>
+bool SudokuKernels<16, IsaLevel::X86_64_V4>::solve(int* cells);
+
+template <int SudokuDimension>
+class SudokuKernelDispatch
+{
+public:
+    using Solve = bool (*)(int*);
+
+    static Solve forIsa(IsaLevel level)
+    {
+        switch (level)
+        {
+        case IsaLevel::Baseline:
+            return &SudokuKernels<SudokuDimension, IsaLevel::Baseline>::solve;
+#if BENCHMARK_SUITE_ISA_DISPATCH
+        case IsaLevel::X86_64_V2:
+            return &SudokuKernels<SudokuDimension, IsaLevel::X86_64_V2>::solve;
+        case IsaLevel::X86_64_V3:
+            return &SudokuKernels<SudokuDimension, IsaLevel::X86_64_V3>::solve;
+        case IsaLevel::X86_64_V4:
+            return &SudokuKernels<SudokuDimension, IsaLevel::X86_64_V4>::solve;
+#endif
+        default:
+            throw std::runtime_error("Sudoku kernels were not compiled for this ISA level!");
+        }
+    }
+};
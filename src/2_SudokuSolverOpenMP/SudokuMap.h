@@ -0,0 +1,219 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class Utility
+{
+public:
+    template <typename... Args>
+    static std::string argsToString(Args&&... args)
+    {
+        std::ostringstream oss;
+        argsToStringHelper(oss, std::forward<Args>(args)...);
+        return oss.str();
+    }
+
+private:
+    template <typename... Args>
+    static void argsToStringHelper(std::ostringstream& oss, Args&&... args)
+    {
+        (oss << ... << std::forward<Args>(args));
+    }
+};
+
+template <int SudokuDimension>
+class SudokuMap
+{
+public:
+    SudokuMap(std::vector<int> elements)
+        : elements_(std::move(elements))
+    {
+        if (elements_.size() != (SudokuDimension * SudokuDimension))
+        {
+            throw std::runtime_error(Utility::argsToString("Number of elements in the sudoku map '", elements_.size(),
+                                                           "' does not match the dimension '", SudokuDimension, "'!\n"));
+        }
+    }
+
+    int getElem(size_t x, size_t y) const
+    {
+        return elements_.at(x + y * SudokuDimension);
+    }
+
+    void setElem(size_t x, size_t y, int i)
+    {
+        elements_.at(x + y * SudokuDimension) = i;
+    }
+
+    int* data()
+    {
+        return elements_.data();
+    }
+
+    bool isCandidate(int x, int y, int value) const
+    {
+        // Check the row
+        for (int col = 0; col < SudokuDimension; col++)
+        {
+            if (getElem(x, col) == value)
+            {
+                return false;
+            }
+        }
+
+        // Check the column
+        for (int row = 0; row < SudokuDimension; row++)
+        {
+            if (getElem(row, y) == value)
+            {
+                return false;
+            }
+        }
+
+        // Check the subgrid
+        constexpr int subgridSize = std::sqrt(SudokuDimension);
+        int subgridRowStart = (x / subgridSize) * subgridSize;
+        int subgridColStart = (y / subgridSize) * subgridSize;
+
+        for (int row = subgridRowStart; row < subgridRowStart + subgridSize; row++)
+        {
+            for (int col = subgridColStart; col < subgridColStart + subgridSize; col++)
+            {
+                if (getElem(row, col) == value)
+                {
+                    return false;
+                }
+            }
+        }
+
+        // If no conflicts, return true
+        return true;
+    }
+
+    void printBoard() const
+    {
+        int i = 0;
+        for (const auto elem : elements_)
+        {
+            std::cout << elem << ", ";
+            i++;
+            if (i == SudokuDimension)
+            {
+                std::cout << "//" << std::endl;
+                i = 0;
+            }
+        }
+    }
+
+private:
+    std::vector<int> elements_;
+};
+
+// Classic 9x9 boards as bitboards: one 128 bit board per value, whose 32 bit lanes hold the 27 cells of one band each,
+// next to the values of the cells. Checking a candidate is a single AND with the row, column and subgrid of the cell.
+template <>
+class SudokuMap<9>
+{
+public:
+    using Bitboard = unsigned __int128;
+
+    SudokuMap(std::vector<int> elements)
+    {
+        if (elements.size() != numOfCells)
+        {
+            throw std::runtime_error(Utility::argsToString("Number of elements in the sudoku map '", elements.size(),
+                                                           "' does not match the dimension '", 9, "'!\n"));
+        }
+
+        for (int cell = 0; cell < numOfCells; cell++)
+        {
+            setElem(cell % 9, cell / 9, elements[cell]);
+        }
+    }
+
+    int getElem(size_t x, size_t y) const
+    {
+        return cells_[x + y * 9];
+    }
+
+    void setElem(size_t x, size_t y, int i)
+    {
+        const int cell = static_cast<int>(x + y * 9);
+        if (cells_[cell] != 0)
+        {
+            values_[cells_[cell] - 1] &= ~bitOf(cell);
+        }
+        cells_[cell] = static_cast<uint8_t>(i);
+        if (i != 0)
+        {
+            values_[i - 1] |= bitOf(cell);
+        }
+    }
+
+    bool isCandidate(int x, int y, int value) const
+    {
+        return (values_[value - 1] & units()[x + y * 9]) == 0;
+    }
+
+    // Cells that hold the value
+    Bitboard valueBoard(int value) const
+    {
+        return values_[value - 1];
+    }
+
+    void printBoard() const
+    {
+        for (int cell = 0; cell < numOfCells; cell++)
+        {
+            std::cout << static_cast<int>(cells_[cell]) << ", ";
+            if (cell % 9 == 8)
+            {
+                std::cout << "//" << std::endl;
+            }
+        }
+    }
+
+    static constexpr int numOfCells = 81;
+
+    static constexpr Bitboard bitOf(int cell)
+    {
+        return Bitboard{1} << (32 * (cell / 27) + cell % 27);
+    }
+
+    static constexpr int cellOf(int bit)
+    {
+        return 27 * (bit / 32) + bit % 32;
+    }
+
+    // Row, column and subgrid of every cell, including the cell itself
+    static const std::array<Bitboard, numOfCells>& units()
+    {
+        static constexpr auto units = [] {
+            auto units = std::array<Bitboard, numOfCells>();
+            for (int cell = 0; cell < numOfCells; cell++)
+            {
+                for (int other = 0; other < numOfCells; other++)
+                {
+                    if (other / 9 == cell / 9 || other % 9 == cell % 9 ||
+                        (other / 27 == cell / 27 && other % 9 / 3 == cell % 9 / 3))
+                    {
+                        units[cell] |= bitOf(other);
+                    }
+                }
+            }
+            return units;
+        }();
+        return units;
+    }
+
+private:
+    std::array<Bitboard, 9> values_{};
+    std::array<uint8_t, numOfCells> cells_{};
+};
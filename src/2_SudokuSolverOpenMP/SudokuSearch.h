@@ -0,0 +1,239 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+// How a sequential search picks the next cell and in which order it tries the values of the cell
+struct SudokuStrategy
+{
+    enum class CellOrder
+    {
+        Raster,
+        MinimumRemainingValues,
+    };
+
+    enum class ValueOrder
+    {
+        Ascending,
+        Descending,
+        Random,
+    };
+
+    CellOrder cellOrder{CellOrder::Raster};
+    ValueOrder valueOrder{ValueOrder::Ascending};
+    uint64_t seed{0}; // Only used for random value orders
+
+    std::string name() const
+    {
+        auto name = std::string(cellOrder == CellOrder::Raster ? "raster" : "mrv");
+        switch (valueOrder)
+        {
+        case ValueOrder::Ascending:
+            return name + "/ascending";
+        case ValueOrder::Descending:
+            return name + "/descending";
+        case ValueOrder::Random:
+            return name + "/random:" + std::to_string(seed);
+        }
+        return name;
+    }
+};
+
+// Sequential backtracking with a configurable strategy, keeping the used values of every row, column and subgrid as
+// bit masks so that picking the cell with the fewest candidates stays cheap. Can be cancelled from other threads, or
+// interrupted after a number of nodes.
+template <int SudokuDimension>
+class SudokuSearch
+{
+public:
+    SudokuSearch(const SudokuMap<SudokuDimension>& puzzle, SudokuStrategy strategy,
+                 const std::atomic<bool>* cancelled = nullptr)
+        : board_(puzzle)
+        , strategy_(strategy)
+        , cancelled_(cancelled)
+        , random_(strategy.seed)
+    {
+        for (int y = 0; y < SudokuDimension; y++)
+        {
+            for (int x = 0; x < SudokuDimension; x++)
+            {
+                if (const int value = board_.getElem(x, y))
+                {
+                    place(x, y, value);
+                }
+            }
+        }
+    }
+
+    // Returns true if a solution was found, which is then on the board. Gives up after maxNodes placed values.
+    bool solve(int64_t maxNodes = std::numeric_limits<int64_t>::max())
+    {
+        maxNodes_ = maxNodes;
+        return solveFrom(0);
+    }
+
+    // Whether the last solve stopped because of cancellation or the node limit, rather than exhausting the search
+    bool interrupted() const
+    {
+        return interrupted_;
+    }
+
+    const SudokuMap<SudokuDimension>& board() const
+    {
+        return board_;
+    }
+
+    // Number of values placed so far
+    int64_t nodes() const
+    {
+        return nodes_;
+    }
+
+private:
+    static constexpr int numOfCells = SudokuDimension * SudokuDimension;
+    static constexpr uint32_t allValues = ((uint32_t{1} << SudokuDimension) - 1) << 1;
+
+    static constexpr int subgridSize()
+    {
+        int size = 1;
+        while (size * size < SudokuDimension)
+        {
+            size++;
+        }
+        return size;
+    }
+
+    static int subgrid(int x, int y)
+    {
+        return (y / subgridSize()) * subgridSize() + x / subgridSize();
+    }
+
+    uint32_t candidates(int x, int y) const
+    {
+        return allValues & ~(rows_[y] | columns_[x] | subgrids_[subgrid(x, y)]);
+    }
+
+    void place(int x, int y, int value)
+    {
+        const uint32_t bit = uint32_t{1} << value;
+        rows_[y] |= bit;
+        columns_[x] |= bit;
+        subgrids_[subgrid(x, y)] |= bit;
+        board_.setElem(x, y, value);
+    }
+
+    void remove(int x, int y, int value)
+    {
+        const uint32_t bit = uint32_t{1} << value;
+        rows_[y] &= ~bit;
+        columns_[x] &= ~bit;
+        subgrids_[subgrid(x, y)] &= ~bit;
+        board_.setElem(x, y, 0);
+    }
+
+    // Next cell to fill at or after the given raster position, or numOfCells if the board is full
+    int nextCell(int start) const
+    {
+        if (strategy_.cellOrder == SudokuStrategy::CellOrder::Raster)
+        {
+            int cell = start;
+            while (cell < numOfCells && board_.getElem(cell % SudokuDimension, cell / SudokuDimension) != 0)
+            {
+                cell++;
+            }
+            return cell;
+        }
+
+        int best = numOfCells;
+        int bestCount = SudokuDimension + 1;
+        for (int cell = 0; cell < numOfCells; cell++)
+        {
+            const int x = cell % SudokuDimension;
+            const int y = cell / SudokuDimension;
+            if (board_.getElem(x, y) != 0)
+            {
+                continue;
+            }
+
+            const int count = std::popcount(candidates(x, y));
+            if (count < bestCount)
+            {
+                best = cell;
+                bestCount = count;
+                if (count <= 1)
+                {
+                    break;
+                }
+            }
+        }
+        return best;
+    }
+
+    bool solveFrom(int start)
+    {
+        const int cell = nextCell(start);
+        if (cell == numOfCells)
+        {
+            return true;
+        }
+        if (nodes_ >= maxNodes_ || (cancelled_ && cancelled_->load(std::memory_order_relaxed)))
+        {
+            interrupted_ = true;
+            return false;
+        }
+
+        const int x = cell % SudokuDimension;
+        const int y = cell / SudokuDimension;
+
+        int values[SudokuDimension];
+        int numOfValues = 0;
+        for (auto mask = candidates(x, y); mask != 0; mask &= mask - 1)
+        {
+            values[numOfValues++] = std::countr_zero(mask);
+        }
+
+        if (strategy_.valueOrder == SudokuStrategy::ValueOrder::Descending)
+        {
+            std::reverse(values, values + numOfValues);
+        }
+        else if (strategy_.valueOrder == SudokuStrategy::ValueOrder::Random)
+        {
+            std::shuffle(values, values + numOfValues, random_);
+        }
+
+        for (int i = 0; i < numOfValues; i++)
+        {
+            nodes_++;
+            place(x, y, values[i]);
+            if (solveFrom(cell + 1))
+            {
+                return true;
+            }
+            remove(x, y, values[i]);
+            if (interrupted_)
+            {
+                break;
+            }
+        }
+
+        return false;
+    }
+
+    SudokuMap<SudokuDimension> board_;
+    const SudokuStrategy strategy_;
+    const std::atomic<bool>* cancelled_;
+    std::mt19937_64 random_;
+    uint32_t rows_[SudokuDimension]{};
+    uint32_t columns_[SudokuDimension]{};
+    uint32_t subgrids_[SudokuDimension]{};
+    int64_t nodes_{0};
+    int64_t maxNodes_{std::numeric_limits<int64_t>::max()};
+    bool interrupted_{false};
+};
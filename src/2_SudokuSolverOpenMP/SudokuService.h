@@ -0,0 +1,135 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// In-process solving service: requests go into one queue, from which a pool of worker threads takes micro-batches of
+// up to maxBatchSize requests. A worker that finds fewer requests waits for more until the oldest one has been queued
+// for maxBatchDelay. Bigger batches cost latency but save the lock handoffs and wakeups of the workers per request.
+template <int SudokuDimension, typename Solver>
+class SudokuService
+{
+public:
+    using Solution = std::shared_ptr<SudokuMap<SudokuDimension>>;
+    using Callback = std::function<void(Solution)>;
+
+    SudokuService(Solver solver, int numOfWorkers, int maxBatchSize, std::chrono::microseconds maxBatchDelay)
+        : solver_(std::move(solver))
+        , maxBatchSize_(maxBatchSize)
+        , maxBatchDelay_(maxBatchDelay)
+    {
+        for (int i = 0; i < numOfWorkers; i++)
+        {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    SudokuService(const SudokuService&) = delete;
+    SudokuService& operator=(const SudokuService&) = delete;
+
+    // Finishes the queued requests before the workers stop
+    ~SudokuService()
+    {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            stopping_ = true;
+        }
+        arrived_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    // The callback is called with the solution, or nullptr if there is none, on one of the worker threads
+    void submit(const SudokuMap<SudokuDimension>& puzzle, Callback done)
+    {
+        {
+            const auto lock = std::lock_guard(mutex_);
+            queue_.push_back(Request{puzzle, std::move(done), std::chrono::steady_clock::now()});
+        }
+        arrived_.notify_one();
+    }
+
+    // Number of batches taken by the workers so far
+    int64_t numOfBatches() const
+    {
+        const auto lock = std::lock_guard(mutex_);
+        return numOfBatches_;
+    }
+
+private:
+    struct Request
+    {
+        SudokuMap<SudokuDimension> puzzle;
+        Callback done;
+        std::chrono::steady_clock::time_point queued;
+    };
+
+    void work()
+    {
+        auto batch = std::vector<Request>();
+        batch.reserve(maxBatchSize_);
+
+        while (takeBatch(batch))
+        {
+            for (auto& request : batch)
+            {
+                request.done(solver_.run(request.puzzle));
+            }
+            batch.clear();
+        }
+    }
+
+    // Waits for the next batch, returns false once the service stops and the queue is empty
+    bool takeBatch(std::vector<Request>& batch)
+    {
+        auto lock = std::unique_lock(mutex_);
+        arrived_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+        if (queue_.empty())
+        {
+            return false;
+        }
+
+        const auto deadline = queue_.front().queued + maxBatchDelay_;
+        arrived_.wait_until(lock, deadline,
+                            [this] { return stopping_ || static_cast<int>(queue_.size()) >= maxBatchSize_; });
+
+        // Another worker may have taken the requests in the meantime, which leaves the batch empty
+        while (!queue_.empty() && static_cast<int>(batch.size()) < maxBatchSize_)
+        {
+            batch.push_back(std::move(queue_.front()));
+            queue_.pop_front();
+        }
+        numOfBatches_ += batch.empty() ? 0 : 1;
+
+        // Requests beyond this batch need another worker
+        if (!queue_.empty())
+        {
+            arrived_.notify_one();
+        }
+        return true;
+    }
+
+    const Solver solver_;
+    const int maxBatchSize_;
+    const std::chrono::microseconds maxBatchDelay_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable arrived_;
+    std::deque<Request> queue_;
+    bool stopping_{false};
+    int64_t numOfBatches_{0};
+
+    std::vector<std::thread> workers_; // Last, so that everything else exists when the workers start
+};
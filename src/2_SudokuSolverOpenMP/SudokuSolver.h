@@ -0,0 +1,124 @@
+#pragma once
+
+#include "SudokuMap.h"
+
+#include <memory>
+
+class SudokuSolver
+{
+public:
+    SudokuSolver(int maxParallelizationDepth)
+        : maxParallelizationDepth_(maxParallelizationDepth)
+    {
+    }
+
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> run(SudokuMap<SudokuDimension>& sudoku, int x = 0, int y = 0,
+                                                    int depth = 1) const
+    {
+        return search(sudoku, x, y, depth, /*inTeam=*/false);
+    }
+
+    // Same search for one thread of a parallel region that the caller keeps open across solves, e.g. in a master
+    // construct while the other threads wait at the closing barrier. The values of the first levels become tasks for
+    // that team instead of forking a new team per solve, the waiting threads pick them up from the barrier.
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> runInTeam(SudokuMap<SudokuDimension>& sudoku) const
+    {
+        return search(sudoku, 0, 0, 1, /*inTeam=*/true);
+    }
+
+private:
+    template <int SudokuDimension>
+    std::shared_ptr<SudokuMap<SudokuDimension>> search(SudokuMap<SudokuDimension>& sudoku, int x, int y, int depth,
+                                                       bool inTeam) const
+    {
+        // If x is beyond the last column, move to the next row
+        if (x >= SudokuDimension)
+        {
+            x = 0;
+            y++;
+            if (y >= SudokuDimension)
+            {
+                // If y is also beyond the last row, the puzzle is solved
+                return std::make_shared<SudokuMap<SudokuDimension>>(sudoku);
+            }
+        }
+
+        // If the current cell is already filled, move to the next one
+        if (sudoku.getElem(x, y) != 0)
+        {
+            return search(sudoku, x + 1, y, depth, inTeam);
+        }
+
+        // Only use OpenMP parallelization until maximum depth to avoid creating too many tasks
+        if (depth < maxParallelizationDepth_)
+        {
+            std::shared_ptr<SudokuMap<SudokuDimension>> solution;
+            if (inTeam)
+            {
+                spawnCandidates(sudoku, x, y, depth, inTeam, solution);
+                return solution;
+            }
+
+#pragma omp parallel shared(solution)
+            {
+#pragma omp single
+                spawnCandidates(sudoku, x, y, depth, inTeam, solution);
+            }
+
+            return solution;
+        }
+        else
+        {
+            // Try placing possible values
+            for (int i = 1; i <= SudokuDimension; i++)
+            {
+                if (sudoku.isCandidate(x, y, i))
+                {
+                    auto newSudoku = sudoku;
+                    newSudoku.setElem(x, y, i);
+                    auto subSolution = search(newSudoku, x + 1, y, depth + 1, inTeam);
+                    if (subSolution != nullptr)
+                    {
+                        return subSolution;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+    }
+
+    // Tries every candidate of the cell in its own task and waits for them
+    template <int SudokuDimension>
+    void spawnCandidates(SudokuMap<SudokuDimension>& sudoku, int x, int y, int depth, bool inTeam,
+                         std::shared_ptr<SudokuMap<SudokuDimension>>& solution) const
+    {
+        // Try placing possible values
+        for (int i = 1; i <= SudokuDimension; i++)
+        {
+            if (sudoku.isCandidate(x, y, i))
+            {
+#pragma omp task firstprivate(sudoku, x, y, i, depth, inTeam) shared(solution)
+                {
+                    sudoku.setElem(x, y, i);
+                    auto subSolution = search(sudoku, x + 1, y, depth + 1, inTeam);
+                    if (subSolution != nullptr)
+                    {
+#pragma omp critical
+                        {
+                            if (!solution)
+                            {
+                                solution = std::move(subSolution);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+#pragma omp taskwait
+    }
+
+    const int maxParallelizationDepth_{1};
+};
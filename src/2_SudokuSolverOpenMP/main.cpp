@@ -1,242 +1,151 @@
 #include <benchmark/benchmark.h>
 #include <omp.h>
 
-#include <cmath>
-#include <iostream>
-#include <memory>
-#include <sstream>
+#include "Common/IsaLevel.h"
+#include "Common/LatencyHistogram.h"
+#include "Common/MemoryTracker.h"
+#include "Common/ProfilingRegion.h"
+#include "Common/SuiteMain.h"
+#include "Common/ThreadPlacement.h"
+
+#include "BackjumpingSudokuSolver.h"
+#include "BitboardSudokuSolver.h"
+#include "FrontierSudokuSolver.h"
+#include "IncrementalSudokuSolver.h"
+#include "OpenLoopLoad.h"
+#include "PortfolioSudokuSolver.h"
+#include "RestartingSudokuSolver.h"
+#include "SplitSudokuSolver.h"
+#include "StackSudokuSolver.h"
+#include "SudokuCorpus.h"
+#include "SudokuKernels.h"
+#include "SudokuMap.h"
+#include "SudokuService.h"
+#include "SudokuSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
-class Utility
+class SudokuSolverTest : public benchmark::Fixture
 {
 public:
-    template <typename... Args>
-    static std::string argsToString(Args&&... args)
+    void SetUp(::benchmark::State& state)
     {
-        std::ostringstream oss;
-        argsToStringHelper(oss, std::forward<Args>(args)...);
-        return oss.str();
+        MemoryTracker::beginRun(state);
     }
 
-private:
-    template <typename... Args>
-    static void argsToStringHelper(std::ostringstream& oss, Args&&... args)
+    void TearDown(::benchmark::State& state)
     {
-        (oss << ... << std::forward<Args>(args));
+        MemoryTracker::endRun(state);
+        ThreadPlacement::unplaceTeam();
     }
-};
 
-template <int SudokuDimension>
-class SudokuMap
-{
-public:
-    SudokuMap(std::vector<int> elements)
-        : elements_(std::move(elements))
+    template <int SudokuDimension>
+    inline static void Run(benchmark::State& state, const SudokuMap<SudokuDimension>& inputSudokuMap,
+                           ThreadPlacement::Policy placement = ThreadPlacement::Policy::None)
     {
-        if (elements_.size() != (SudokuDimension * SudokuDimension))
+        const int numOfThreads = state.range(0);
+        omp_set_num_threads(numOfThreads);
+        ThreadPlacement::placeTeam(placement, numOfThreads);
+        if (placement != ThreadPlacement::Policy::None)
         {
-            throw std::runtime_error(Utility::argsToString("Number of elements in the sudoku map '", elements_.size(),
-                                                           "' does not match the dimension '", SudokuDimension, "'!\n"));
+            state.SetLabel(ThreadPlacement::name(placement));
         }
-    }
-
-    int getElem(size_t x, size_t y) const
-    {
-        return elements_.at(x + y * SudokuDimension);
-    }
 
-    void setElem(size_t x, size_t y, int i)
-    {
-        elements_.at(x + y * SudokuDimension) = i;
+        const int maxParallelizationDepth = state.range(1);
+        RunSolver(state, inputSudokuMap, SudokuSolver(maxParallelizationDepth));
     }
 
-    bool isCandidate(int x, int y, int value) const
+    template <int SudokuDimension, typename Solver>
+    inline static void RunSolver(benchmark::State& state, const SudokuMap<SudokuDimension>& inputSudokuMap,
+                                 const Solver& sudokuSolver)
     {
-        // Check the row
-        for (int col = 0; col < SudokuDimension; col++)
-        {
-            if (getElem(x, col) == value)
-            {
-                return false;
-            }
-        }
+        auto latencies = LatencyHistogram();
 
-        // Check the column
-        for (int row = 0; row < SudokuDimension; row++)
-        {
-            if (getElem(row, y) == value)
-            {
-                return false;
-            }
-        }
-
-        // Check the subgrid
-        constexpr int subgridSize = std::sqrt(SudokuDimension);
-        int subgridRowStart = (x / subgridSize) * subgridSize;
-        int subgridColStart = (y / subgridSize) * subgridSize;
-
-        for (int row = subgridRowStart; row < subgridRowStart + subgridSize; row++)
+        const auto profilingRegion = ProfilingRegion();
+        for (auto _ : state)
         {
-            for (int col = subgridColStart; col < subgridColStart + subgridSize; col++)
-            {
-                if (getElem(row, col) == value)
-                {
-                    return false;
-                }
-            }
-        }
+            const auto start = std::chrono::steady_clock::now();
+            auto sudokuMap = inputSudokuMap;
+            auto solution = sudokuSolver.run(sudokuMap);
+            latencies.record(std::chrono::steady_clock::now() - start);
 
-        // If no conflicts, return true
-        return true;
-    }
+            if (!solution)
+                throw std::runtime_error("Solution could not be found!");
 
-    void printBoard() const
-    {
-        int i = 0;
-        for (const auto elem : elements_)
-        {
-            std::cout << elem << ", ";
-            i++;
-            if (i == SudokuDimension)
-            {
-                std::cout << "//" << std::endl;
-                i = 0;
-            }
+            benchmark::DoNotOptimize(*solution);
         }
-    }
 
-private:
-    std::vector<int> elements_;
-};
-
-class SudokuSolver
-{
-public:
-    SudokuSolver(int maxParallelizationDepth)
-        : maxParallelizationDepth_(maxParallelizationDepth)
-    {
+        latencies.publish(state, "solve_");
     }
 
+    // Keeps one parallel region open over all iterations instead of forking a team per solve. The first thread runs the
+    // benchmark loop in a master construct, the others wait at the closing barrier of the region, spinning briefly
+    // before they sleep (see OMP_WAIT_POLICY and GOMP_SPINCOUNT), and take the tasks of every solve from there.
     template <int SudokuDimension>
-    std::shared_ptr<SudokuMap<SudokuDimension>> run(SudokuMap<SudokuDimension>& sudoku, int x = 0, int y = 0,
-                                                    int depth = 1) const
+    inline static void RunInTeam(benchmark::State& state, const SudokuMap<SudokuDimension>& inputSudokuMap)
     {
-        // If x is beyond the last column, move to the next row
-        if (x >= SudokuDimension)
-        {
-            x = 0;
-            y++;
-            if (y >= SudokuDimension)
-            {
-                // If y is also beyond the last row, the puzzle is solved
-                return std::make_shared<SudokuMap<SudokuDimension>>(sudoku);
-            }
-        }
-
-        // If the current cell is already filled, move to the next one
-        if (sudoku.getElem(x, y) != 0)
-        {
-            return run(sudoku, x + 1, y, depth);
-        }
+        const int numOfThreads = state.range(0);
+        const auto sudokuSolver = SudokuSolver(state.range(1));
+        auto latencies = LatencyHistogram();
 
-        // Only use OpenMP parallelization until maximum depth to avoid creating too many tasks
-        if (depth < maxParallelizationDepth_)
+        const auto profilingRegion = ProfilingRegion();
+#pragma omp parallel num_threads(numOfThreads)
+#pragma omp master
+        for (auto _ : state)
         {
-            std::shared_ptr<SudokuMap<SudokuDimension>> solution;
-
-#pragma omp parallel shared(solution)
-            {
-#pragma omp single
-                {
-                    // Try placing possible values
-                    for (int i = 1; i <= SudokuDimension; i++)
-                    {
-                        if (sudoku.isCandidate(x, y, i))
-                        {
-#pragma omp task firstprivate(sudoku, x, y, i, depth) shared(solution)
-                            {
-                                sudoku.setElem(x, y, i);
-                                auto subSolution = run(sudoku, x + 1, y, depth + 1);
-                                if (subSolution != nullptr)
-                                {
-#pragma omp critical
-                                    {
-                                        if (!solution)
-                                        {
-                                            solution = std::move(subSolution);
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-#pragma omp taskwait
-                }
-            }
+            const auto start = std::chrono::steady_clock::now();
+            auto sudokuMap = inputSudokuMap;
+            auto solution = sudokuSolver.runInTeam(sudokuMap);
+            latencies.record(std::chrono::steady_clock::now() - start);
 
-            return solution;
-        }
-        else
-        {
-            // Try placing possible values
-            for (int i = 1; i <= SudokuDimension; i++)
+            // Exceptions must not leave the parallel region
+            if (!solution)
             {
-                if (sudoku.isCandidate(x, y, i))
-                {
-                    auto newSudoku = sudoku;
-                    newSudoku.setElem(x, y, i);
-                    auto subSolution = run(newSudoku, x + 1, y, depth + 1);
-                    if (subSolution != nullptr)
-                    {
-                        return subSolution;
-                    }
-                }
+                state.SkipWithError("Solution could not be found!");
+                break;
             }
 
-            return nullptr;
+            benchmark::DoNotOptimize(*solution);
         }
-    }
-
-private:
-    const int maxParallelizationDepth_{1};
-};
 
-class SudokuSolverTest : public benchmark::Fixture
-{
-public:
-    void SetUp(::benchmark::State& state)
-    {
-    }
-
-    void TearDown(::benchmark::State& state)
-    {
+        latencies.publish(state, "solve_");
     }
 
-    template <int SudokuDimension>
-    inline static void Run(benchmark::State& state, const SudokuMap<SudokuDimension>& inputSudokuMap)
+    // Solves the whole corpus per iteration and reports the percentiles of the solve time of a single puzzle, which show
+    // the heavy tail of backtracking that the mean hides
+    template <int SudokuDimension, typename Solver>
+    inline static void RunCorpus(benchmark::State& state, const std::vector<SudokuMap<SudokuDimension>>& corpus,
+                                 const Solver& sudokuSolver)
     {
-        const int numOfThreads = state.range(0);
-        omp_set_num_threads(numOfThreads);
-
-        const int maxParallelizationDepth = state.range(1);
-        const auto sudokuSolver = SudokuSolver(maxParallelizationDepth);
+        auto latencies = LatencyHistogram();
 
+        const auto profilingRegion = ProfilingRegion();
         for (auto _ : state)
         {
-            auto sudokuMap = inputSudokuMap;
-            auto solution = sudokuSolver.run(sudokuMap);
+            for (const auto& puzzle : corpus)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                auto solution = sudokuSolver.run(puzzle);
+                latencies.record(std::chrono::steady_clock::now() - start);
 
-            if (!solution)
-                throw std::runtime_error("Solution could not be found!");
+                if (!solution)
+                    throw std::runtime_error("Solution could not be found!");
 
-            benchmark::DoNotOptimize(*solution);
+                benchmark::DoNotOptimize(*solution);
+            }
         }
+
+        latencies.publish(state, "solve_");
     }
-};
 
-BENCHMARK_DEFINE_F(SudokuSolverTest, NullDifficulty)(benchmark::State& state)
-{
-    const auto sudokuMapComplete_ = SudokuMap<16>({
+protected:
+    inline static const auto sudokuMapComplete_ = SudokuMap<16>({
         3,  7,  6,  8,  5,  14, 10, 9,  13, 2,  1,  15, 11, 12, 16, 4,  //
         13, 16, 15, 10, 12, 11, 1,  2,  7,  9,  14, 4,  8,  6,  5,  3,  //
         12, 4,  14, 9,  13, 3,  6,  16, 8,  10, 5,  11, 1,  15, 2,  7,  //
@@ -254,18 +163,8 @@ BENCHMARK_DEFINE_F(SudokuSolverTest, NullDifficulty)(benchmark::State& state)
         8,  9,  3,  5,  7,  16, 15, 11, 12, 4,  10, 2,  6,  14, 1,  13, //
         7,  11, 10, 16, 14, 4,  12, 5,  1,  8,  13, 6,  15, 3,  9,  2,  //
     });
-    Run(state, sudokuMapComplete_);
-}
-BENCHMARK_REGISTER_F(SudokuSolverTest, NullDifficulty)
-    ->Unit(benchmark::kMicrosecond)
-    ->ArgsProduct({
-        {1, 4}, // Number of threads
-        {1, 8}, // Maximum depth for parallelization
-    });
 
-BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficulty)(benchmark::State& state)
-{
-    const auto sudokuMapEasy_ = SudokuMap<16>({
+    inline static const auto sudokuMapEasy_ = SudokuMap<16>({
         0,  0,  6,  0,  0,  14, 10, 00, 13, 2,  0,  15, 0,  0,  0,  4,  //
         0,  16, 15, 0,  12, 0,  0,  2,  7,  9,  0,  4,  0,  0,  5,  3,  //
         12, 0,  14, 0,  13, 3,  6,  0,  0,  0,  5,  0,  1,  0,  0,  0,  //
@@ -283,6 +182,41 @@ BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficulty)(benchmark::State& state)
         0,  9,  3,  0,  0,  0,  0,  11, 0,  0,  10, 0,  0,  14, 0,  13, //
         0,  0,  10, 16, 14, 0,  0,  5,  0,  0,  13, 0,  0,  0,  0,  0   //
     });
+
+    // Puzzles from 96 to 124 empty cells, where raster order backtracking already shows a heavy tail
+    inline static const auto mixedCorpus_ = SudokuCorpus<16>::generate(sudokuMapComplete_, 32, 96, 124, /*seed=*/2024);
+
+    // Puzzles from 136 to 150 empty cells, where even minimum remaining values order runs into seconds on some
+    inline static const auto hardCorpus_ = SudokuCorpus<16>::generate(sudokuMapComplete_, 16, 136, 150, /*seed=*/4711);
+
+    // Minimal classic puzzles with a unique solution, generated on first use
+    static const std::vector<SudokuMap<9>>& classicCorpus()
+    {
+        static const auto corpus = [] {
+            const auto sudokuSolver = BitboardSudokuSolver();
+            const auto countSolutions = [&](const SudokuMap<9>& puzzle, int64_t limit)
+            { return sudokuSolver.countSolutions(puzzle, limit); };
+            return SudokuCorpus<9>::minimize(SudokuCorpus<9>::generate(SudokuCorpus<9>::pattern(), 256, 0, 0, 9),
+                                             /*seed=*/9, countSolutions);
+        }();
+        return corpus;
+    }
+};
+
+BENCHMARK_DEFINE_F(SudokuSolverTest, NullDifficulty)(benchmark::State& state)
+{
+    Run(state, sudokuMapComplete_);
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, NullDifficulty)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        {1, 4}, // Number of threads
+        {1, 8}, // Maximum depth for parallelization
+    })
+    ->ArgNames({"threads", "depth"});
+
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficulty)(benchmark::State& state)
+{
     Run(state, sudokuMapEasy_);
 }
 BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficulty)
@@ -290,6 +224,360 @@ BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficulty)
     ->ArgsProduct({
         benchmark::CreateDenseRange(1, 16, /*step=*/1),  // Number of threads
         benchmark::CreateRange(1, 64, /*multiplier=*/2), // Maximum depth for parallelization
-    });
+    })
+    ->ArgNames({"threads", "depth"});
+
+// Same searches as NullDifficulty and EasyDifficulty, but within one team that persists across the iterations, so the
+// difference to those is the cost of forking and joining the team per solve
+BENCHMARK_DEFINE_F(SudokuSolverTest, NullDifficultyPersistentTeam)(benchmark::State& state)
+{
+    RunInTeam(state, sudokuMapComplete_);
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, NullDifficultyPersistentTeam)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        {1, 4}, // Number of threads
+        {1, 8}, // Maximum depth for parallelization
+    })
+    ->ArgNames({"threads", "depth"});
+
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficultyPersistentTeam)(benchmark::State& state)
+{
+    RunInTeam(state, sudokuMapEasy_);
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficultyPersistentTeam)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(1, 16, /*step=*/1),  // Number of threads
+        benchmark::CreateRange(1, 64, /*multiplier=*/2), // Maximum depth for parallelization
+    })
+    ->ArgNames({"threads", "depth"});
+
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficultyPlaced)(benchmark::State& state)
+{
+    Run(state, sudokuMapEasy_, static_cast<ThreadPlacement::Policy>(state.range(2)));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficultyPlaced)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(1, 16, /*step=*/1), // Number of threads
+        {2, 8},                                         // Maximum depth for parallelization
+        {
+            static_cast<int>(ThreadPlacement::Policy::Compact),
+            static_cast<int>(ThreadPlacement::Policy::Scatter),
+            static_cast<int>(ThreadPlacement::Policy::PhysicalCores),
+            static_cast<int>(ThreadPlacement::Policy::OnePerL3),
+        }, // Thread placement policy
+    })
+    ->ArgNames({"threads", "depth", "placement"});
+
+// Breadth first expansion into at least k boards per thread, which the threads then search depth first
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficultyFrontier)(benchmark::State& state)
+{
+    const int numOfThreads = state.range(0);
+    const int frontierFactor = state.range(1);
+    RunSolver(state, sudokuMapEasy_, FrontierSudokuSolver(numOfThreads, frontierFactor));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficultyFrontier)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(1, 16, /*step=*/1),  // Number of threads
+        benchmark::CreateRange(1, 16, /*multiplier=*/4), // Minimum frontier size per thread
+    })
+    ->ArgNames({"threads", "k"});
+
+// Iterative search where idle threads steal the oldest untried values from the stacks of busy threads within the
+// first depth frames. Reports the time each thread spent without work per iteration, as idle_t<thread>, as mean and
+// maximum over the threads, and the share of idle time in the total thread time.
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficultyStack)(benchmark::State& state)
+{
+    const int numOfThreads = state.range(0);
+    const int maxStealDepth = state.range(1);
+    const auto sudokuSolver = StackSudokuSolver(numOfThreads, maxStealDepth);
+
+    auto idleSeconds = std::vector<double>();
+    auto threadIdleSeconds = std::vector<double>(numOfThreads);
+    double totalIdleSeconds = 0.0;
+    double maxIdleSeconds = 0.0;
+    double wallSeconds = 0.0;
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto solution = sudokuSolver.run(sudokuMapEasy_, &idleSeconds);
+        wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!solution)
+            throw std::runtime_error("Solution could not be found!");
+
+        benchmark::DoNotOptimize(*solution);
+
+        std::transform(idleSeconds.begin(), idleSeconds.end(), threadIdleSeconds.begin(), threadIdleSeconds.begin(),
+                       std::plus<>());
+        totalIdleSeconds += std::accumulate(idleSeconds.begin(), idleSeconds.end(), 0.0);
+        maxIdleSeconds += *std::max_element(idleSeconds.begin(), idleSeconds.end());
+    }
+
+    for (int thread = 0; thread < numOfThreads; thread++)
+    {
+        state.counters["idle_t" + std::to_string(thread)] =
+            benchmark::Counter(threadIdleSeconds[thread], benchmark::Counter::kAvgIterations);
+    }
+    state.counters["idle_mean"] = benchmark::Counter(totalIdleSeconds / numOfThreads, benchmark::Counter::kAvgIterations);
+    state.counters["idle_max"] = benchmark::Counter(maxIdleSeconds, benchmark::Counter::kAvgIterations);
+    state.counters["idle_share"] = benchmark::Counter(totalIdleSeconds / (wallSeconds * numOfThreads));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficultyStack)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgsProduct({
+        benchmark::CreateDenseRange(1, 16, /*step=*/1),  // Number of threads
+        benchmark::CreateRange(1, 64, /*multiplier=*/2), // Maximum depth of frames to steal from
+    })
+    ->ArgNames({"threads", "depth"});
+
+// Single strategy parallel search on the mixed corpus: raster or minimum remaining values cell order, split breadth
+// first over the threads
+BENCHMARK_DEFINE_F(SudokuSolverTest, MixedCorpusSplit)(benchmark::State& state)
+{
+    const int numOfThreads = state.range(0);
+    const auto strategy = PortfolioSudokuSolver::defaultStrategies().at(state.range(1));
+    state.SetLabel(strategy.name());
+    RunCorpus(state, mixedCorpus_, SplitSudokuSolver(numOfThreads, strategy));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, MixedCorpusSplit)
+    ->Unit(benchmark::kMillisecond)
+    ->ArgsProduct({
+        benchmark::CreateRange(1, 16, /*multiplier=*/2), // Number of threads
+        {0, 1},                                          // Strategy: raster or minimum remaining values
+    })
+    ->ArgNames({"threads", "strategy"});
+
+// Portfolio of differently configured searches racing on the mixed corpus
+BENCHMARK_DEFINE_F(SudokuSolverTest, MixedCorpusPortfolio)(benchmark::State& state)
+{
+    const int numOfThreads = state.range(0);
+    RunCorpus(state, mixedCorpus_, PortfolioSudokuSolver(numOfThreads));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, MixedCorpusPortfolio)
+    ->Unit(benchmark::kMillisecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 16)
+    ->ArgNames({"threads"});
+
+// Sequential minimum remaining values search with random value order on the hard corpus, restarted with a fresh seed
+// after 100 nodes times the Luby sequence, or after 100 nodes growing by 1.5 per restart, or never
+BENCHMARK_DEFINE_F(SudokuSolverTest, HardCorpusRestarts)(benchmark::State& state)
+{
+    const auto policy = RestartPolicy(static_cast<RestartPolicy::Schedule>(state.range(0)), /*unitNodes=*/100);
+    state.SetLabel(policy.name());
+
+    auto strategy = SudokuStrategy();
+    strategy.cellOrder = SudokuStrategy::CellOrder::MinimumRemainingValues;
+    strategy.valueOrder = SudokuStrategy::ValueOrder::Random;
+    RunCorpus(state, hardCorpus_, RestartingSudokuSolver(policy, strategy, /*seed=*/1));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, HardCorpusRestarts)
+    ->Unit(benchmark::kMillisecond)
+    ->Args({static_cast<int>(RestartPolicy::Schedule::None)})
+    ->Args({static_cast<int>(RestartPolicy::Schedule::Luby)})
+    ->Args({static_cast<int>(RestartPolicy::Schedule::Geometric)})
+    ->ArgNames({"schedule"});
+
+// Open loop load at a fixed rate on the solving service, whose workers solve the mixed corpus with minimum remaining
+// values order. Sweeping the offered rate for one batching configuration gives its curve of throughput (items per
+// second) against the p99 latency, which counts from the scheduled send time up to the answer.
+BENCHMARK_DEFINE_F(SudokuSolverTest, MixedCorpusService)(benchmark::State& state)
+{
+    const int requestsPerSecond = state.range(0);
+    const int numOfWorkers = state.range(1);
+    const int maxBatchSize = state.range(2);
+    const auto maxBatchDelay = std::chrono::microseconds(state.range(3));
+    const int64_t numOfRequests = 256;
+
+    auto strategy = SudokuStrategy();
+    strategy.cellOrder = SudokuStrategy::CellOrder::MinimumRemainingValues;
+    const auto sudokuSolver = SplitSudokuSolver(/*numOfThreads=*/1, strategy, /*frontierFactor=*/1);
+    auto service = SudokuService<16, SplitSudokuSolver>(sudokuSolver, numOfWorkers, maxBatchSize, maxBatchDelay);
+    const auto load = OpenLoopLoad(requestsPerSecond);
+    auto latencies = LatencyHistogram();
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        if (load.run(service, mixedCorpus_, numOfRequests, latencies) != 0)
+            throw std::runtime_error("Solution could not be found!");
+    }
+
+    state.SetItemsProcessed(state.iterations() * numOfRequests);
+    state.counters["offered"] = requestsPerSecond;
+    state.counters["batch_mean"] = static_cast<double>(state.iterations() * numOfRequests) / service.numOfBatches();
+    latencies.publish(state);
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, MixedCorpusService)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({
+        {500, 1000, 2000, 4000, 8000, 16000}, // Offered requests per second
+        {1, 4},                               // Number of worker threads
+        {1, 8, 32},                           // Maximum batch size
+        {50, 500},                            // Maximum batch delay in microseconds
+    })
+    ->ArgNames({"rate", "workers", "batch", "delay_us"});
+
+// Stream of random clue edits on the first puzzle of the mixed corpus, answered by a cold minimum remaining values
+// search from the clues after every edit, or by the incremental solver that keeps the previous solution. Reports the
+// edit-to-answer latency, and for the incremental solver the share of edits that kept the solution, repaired it around
+// the edited cell or had to solve again.
+BENCHMARK_DEFINE_F(SudokuSolverTest, MixedCorpusEdits)(benchmark::State& state)
+{
+    const bool incremental = state.range(0) != 0;
+    state.SetLabel(incremental ? "incremental" : "cold");
+
+    // Generated on first use, as checking that the puzzle stays solvable takes a while
+    static const auto edits = SudokuCorpus<16>::edits(mixedCorpus_.front(), 256, /*seed=*/99);
+
+    auto strategy = SudokuStrategy();
+    strategy.cellOrder = SudokuStrategy::CellOrder::MinimumRemainingValues;
+    auto sudokuSolver = IncrementalSudokuSolver<16>(strategy);
+    using Answer = IncrementalSudokuSolver<16>::Answer;
+
+    auto latencies = LatencyHistogram();
+    int64_t answers[4]{};
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto clues = mixedCorpus_.front();
+        sudokuSolver.reset(clues);
+        state.ResumeTiming();
+
+        for (const auto& edit : edits)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            if (incremental)
+            {
+                const auto answer = sudokuSolver.setClue(edit.x, edit.y, edit.value);
+                if (answer == Answer::Unsolvable)
+                    throw std::runtime_error("Solution could not be found!");
+
+                answers[static_cast<int>(answer)]++;
+            }
+            else
+            {
+                clues.setElem(edit.x, edit.y, edit.value);
+                auto search = SudokuSearch<16>(clues, strategy);
+                if (!search.solve())
+                    throw std::runtime_error("Solution could not be found!");
+
+                benchmark::DoNotOptimize(search.board());
+            }
+            latencies.record(std::chrono::steady_clock::now() - start);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(edits.size()));
+    latencies.publish(state, "edit_");
+    if (incremental)
+    {
+        const auto numOfEdits = static_cast<double>(state.iterations() * static_cast<int64_t>(edits.size()));
+        state.counters["kept"] = answers[static_cast<int>(Answer::Kept)] / numOfEdits;
+        state.counters["repaired"] = answers[static_cast<int>(Answer::Repaired)] / numOfEdits;
+        state.counters["resolved"] = answers[static_cast<int>(Answer::Resolved)] / numOfEdits;
+    }
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, MixedCorpusEdits)
+    ->Unit(benchmark::kMillisecond)
+    ->DenseRange(0, 1)
+    ->ArgNames({"incremental"});
+
+// Single threaded solves of minimal 9x9 puzzles, by the generic search in raster or minimum remaining values order,
+// which works on the 9x9 bitboards of SudokuMap<9> through the same interface as on the larger boards, or by the
+// solver that propagates on the bitboards directly. Items per second are puzzles per second.
+BENCHMARK_DEFINE_F(SudokuSolverTest, ClassicCorpus)(benchmark::State& state)
+{
+    const int solver = state.range(0);
+    if (solver < 2)
+    {
+        const auto strategy = PortfolioSudokuSolver::defaultStrategies().at(solver);
+        state.SetLabel(strategy.name());
+        RunCorpus(state, classicCorpus(), SplitSudokuSolver(/*numOfThreads=*/1, strategy, /*frontierFactor=*/1));
+    }
+    else
+    {
+        state.SetLabel("bitboard");
+        RunCorpus(state, classicCorpus(), BitboardSudokuSolver());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(classicCorpus().size()));
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, ClassicCorpus)
+    ->Unit(benchmark::kMillisecond)
+    ->DenseRange(0, 2)
+    ->ArgNames({"solver"});
+
+// Forward checking search in minimum remaining values order on the hard corpus, with chronological backtracking, with
+// conflict-directed backjumping, or with backjumping and up to 256 learned nogoods. Reports the placed values per
+// corpus next to the time.
+BENCHMARK_DEFINE_F(SudokuSolverTest, HardCorpusBackjumping)(benchmark::State& state)
+{
+    const int mode = state.range(0);
+    const auto sudokuSolver = BackjumpingSudokuSolver(/*backjumping=*/mode > 0, /*nogoodCapacity=*/mode > 1 ? 256 : 0);
+    state.SetLabel(mode == 0 ? "chronological" : mode == 1 ? "backjumping" : "backjumping/nogoods:256");
+
+    int64_t nodes = 0;
+    auto latencies = LatencyHistogram();
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        for (const auto& puzzle : hardCorpus_)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            auto solution = sudokuSolver.run(puzzle, &nodes);
+            latencies.record(std::chrono::steady_clock::now() - start);
+
+            if (!solution)
+                throw std::runtime_error("Solution could not be found!");
+
+            benchmark::DoNotOptimize(*solution);
+        }
+    }
+
+    state.counters["nodes"] = benchmark::Counter(static_cast<double>(nodes), benchmark::Counter::kAvgIterations);
+    latencies.publish(state, "solve_");
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, HardCorpusBackjumping)
+    ->Unit(benchmark::kMillisecond)
+    ->DenseRange(0, 2)
+    ->ArgNames({"mode"});
+
+// Single threaded solve with the backtracking kernel compiled for every x86-64 microarchitecture level
+BENCHMARK_DEFINE_F(SudokuSolverTest, EasyDifficultyPerIsa)(benchmark::State& state)
+{
+    const auto level = static_cast<IsaLevel>(state.range(0));
+    state.SetLabel(IsaSupport::name(level));
+    if (!IsaSupport::isSupported(level))
+    {
+        state.SkipWithError("ISA level not supported by this cpu or build");
+        return;
+    }
+
+    const auto solve = SudokuKernelDispatch<16>::forIsa(level);
+
+    const auto profilingRegion = ProfilingRegion();
+    for (auto _ : state)
+    {
+        auto sudokuMap = sudokuMapEasy_;
+        if (!solve(sudokuMap.data()))
+            throw std::runtime_error("Solution could not be found!");
+
+        benchmark::DoNotOptimize(sudokuMap);
+    }
+}
+BENCHMARK_REGISTER_F(SudokuSolverTest, EasyDifficultyPerIsa)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4))
+    ->ArgNames({"isa"});
 
-BENCHMARK_MAIN();
+SUITE_MAIN();
@@ -0,0 +1,73 @@
+#include "FmaKernels.h"
+
+// Compiled once per ISA level, see add_isa_variants
+constexpr auto isaLevel = static_cast<IsaLevel>(ISA_LEVEL);
+
+namespace
+{
+constexpr int vectorBytes = isaLevel == IsaLevel::X86_64_V4 ? 64 : isaLevel == IsaLevel::X86_64_V3 ? 32 : 16;
+constexpr int vectorLanes = vectorBytes / sizeof(double);
+
+using Vector = double __attribute__((vector_size(vectorBytes)));
+} // namespace
+
+// The accumulators of the scalar kernel must not be packed into vectors by the compiler
+template <>
+__attribute__((optimize("no-tree-vectorize", "no-tree-slp-vectorize"))) double
+FmaKernels<isaLevel>::scalar(int64_t repetitions, double factor, double addend)
+{
+    double accumulators[numOfChains];
+    for (int i = 0; i < numOfChains; i++)
+    {
+        accumulators[i] = i;
+    }
+
+    for (int64_t repetition = 0; repetition < repetitions; repetition++)
+    {
+        for (int i = 0; i < numOfChains; i++)
+        {
+            accumulators[i] = accumulators[i] * factor + addend;
+        }
+    }
+
+    double sum = 0;
+    for (int i = 0; i < numOfChains; i++)
+    {
+        sum += accumulators[i];
+    }
+    return sum;
+}
+
+template <>
+double FmaKernels<isaLevel>::simd(int64_t repetitions, double factor, double addend)
+{
+    Vector accumulators[numOfChains];
+    for (int i = 0; i < numOfChains; i++)
+    {
+        accumulators[i] = Vector{} + i;
+    }
+
+    for (int64_t repetition = 0; repetition < repetitions; repetition++)
+    {
+        for (int i = 0; i < numOfChains; i++)
+        {
+            accumulators[i] = accumulators[i] * factor + addend;
+        }
+    }
+
+    double sum = 0;
+    for (int i = 0; i < numOfChains; i++)
+    {
+        for (int lane = 0; lane < vectorLanes; lane++)
+        {
+            sum += accumulators[i][lane];
+        }
+    }
+    return sum;
+}
+
+template <>
+int FmaKernels<isaLevel>::simdLanes()
+{
+    return vectorLanes;
+}
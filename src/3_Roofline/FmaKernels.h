@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Common/IsaLevel.h"
+
+#include <cstdint>
+
+// Peak floating point throughput kernels, compiled once per ISA level by add_isa_variants. Every repetition does a
+// multiply add, acc = acc * factor + addend, on each of numOfChains independent accumulators, enough to hide the
+// latency of the FMA units of current cores. The scalar kernel uses single doubles, the SIMD kernel the widest vectors
+// of doubles of the level. Levels without FMA instructions do a separate multiply and add, which still counts as two
+// flops. Both return the sum of the accumulators.
+template <IsaLevel Level>
+class FmaKernels
+{
+public:
+    static constexpr int numOfChains = 16;
+
+    static double scalar(int64_t repetitions, double factor, double addend);
+    static double simd(int64_t repetitions, double factor, double addend);
+
+    // Doubles per vector of the SIMD kernel
+    static int simdLanes();
+};
+
+// Defined by the variant of each level, see add_isa_variants
+template <>
+double FmaKernels<IsaLevel::Baseline>::scalar(int64_t repetitions, double factor, double addend);
+template <>
+double FmaKernels<IsaLevel::Baseline>::simd(int64_t repetitions, double factor, double addend);
+template <>
+int FmaKernels<IsaLevel::Baseline>::simdLanes();
+
+template <>
+double FmaKernels<IsaLevel::X86_64_V2>::scalar(int64_t repetitions, double factor, double addend);
+template <>
+double FmaKernels<IsaLevel::X86_64_V2>::simd(int64_t repetitions, double factor, double addend);
+template <>
+int FmaKernels<IsaLevel::X86_64_V2>::simdLanes();
+
+template <>
+double FmaKernels<IsaLevel::X86_64_V3>::scalar(int64_t repetitions, double factor, double addend);
+template <>
+double FmaKernels<IsaLevel::X86_64_V3>::simd(int64_t repetitions, double factor, double addend);
+template <>
+int FmaKernels<IsaLevel::X86_64_V3>::simdLanes();
+
+template <>
+double FmaKernels<IsaLevel::X86_64_V4>::scalar(int64_t repetitions, double factor, double addend);
+template <>
+double FmaKernels<IsaLevel::X86_64_V4>::simd(int64_t repetitions, double factor, double addend);
+template <>
+int FmaKernels<IsaLevel::X86_64_V4>::simdLanes();
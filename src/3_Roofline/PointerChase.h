@@ -0,0 +1,79 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Cycle of pointers through a working set for measuring the latency of loads: every load depends on the one before,
+// so the time per load is the latency of the memory level that holds the working set. The random pattern visits every
+// cache line of the working set in random order. The strided pattern visits one line per page in random page order,
+// at an offset that grows with the page so that the lines spread over the cache sets, which makes it miss the TLB long
+// before it misses the caches.
+class PointerChase
+{
+public:
+    enum class Pattern
+    {
+        Random,
+        Strided,
+    };
+
+    static const char* name(Pattern pattern)
+    {
+        return pattern == Pattern::Random ? "random" : "strided";
+    }
+
+    PointerChase(size_t workingSetBytes, Pattern pattern, uint64_t seed = 1)
+        : slots_(std::max(workingSetBytes / sizeof(void*), size_t{1}))
+    {
+        const size_t lineBytes = cacheLineBytes();
+        const size_t pageBytes = sysconf(_SC_PAGESIZE);
+        const size_t stride = pattern == Pattern::Random ? lineBytes : pageBytes;
+        const size_t numOfNodes = std::max<size_t>(workingSetBytes / stride, 1);
+
+        auto order = std::vector<size_t>(numOfNodes);
+        std::iota(order.begin(), order.end(), 0);
+        auto random = std::mt19937_64(seed);
+        std::shuffle(order.begin(), order.end(), random);
+
+        auto slotOf = [&](size_t node) {
+            const size_t offset = pattern == Pattern::Random ? 0 : node % (pageBytes / lineBytes) * lineBytes;
+            return (node * stride + offset) / sizeof(void*);
+        };
+        for (size_t i = 0; i < numOfNodes; i++)
+        {
+            slots_[slotOf(order[i])] = &slots_[slotOf(order[(i + 1) % numOfNodes])];
+        }
+        position_ = &slots_[slotOf(order[0])];
+    }
+
+    // Follows the cycle for the given number of loads from where the last call stopped
+    void chase(int64_t numOfLoads)
+    {
+        void* const* position = position_;
+        for (int64_t i = 0; i < numOfLoads; i++)
+        {
+            position = static_cast<void* const*>(*position);
+        }
+        position_ = position;
+    }
+
+    const void* position() const
+    {
+        return position_;
+    }
+
+private:
+    static size_t cacheLineBytes()
+    {
+        const long bytes = sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+        return bytes > 0 ? bytes : 64;
+    }
+
+    std::vector<void*> slots_;
+    void* const* position_{nullptr};
+};
@@ -0,0 +1,339 @@
+#include <benchmark/benchmark.h>
+#include <omp.h>
+
+#include "Common/CpuTopology.h"
+#include "Common/IsaLevel.h"
+#include "Common/MemoryTracker.h"
+#include "Common/Roofline.h"
+#include "Common/SuiteMain.h"
+#include "Common/ThreadPlacement.h"
+
+#include "FmaKernels.h"
+#include "PointerChase.h"
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Kernels of one ISA level, to be selected at runtime
+struct FmaKernelTable
+{
+    decltype(&FmaKernels<IsaLevel::Baseline>::scalar) scalar;
+    decltype(&FmaKernels<IsaLevel::Baseline>::simd) simd;
+    decltype(&FmaKernels<IsaLevel::Baseline>::simdLanes) simdLanes;
+
+    template <IsaLevel Level>
+    static constexpr FmaKernelTable of()
+    {
+        return {
+            &FmaKernels<Level>::scalar,
+            &FmaKernels<Level>::simd,
+            &FmaKernels<Level>::simdLanes,
+        };
+    }
+
+    static FmaKernelTable forIsa(IsaLevel level)
+    {
+        switch (level)
+        {
+        case IsaLevel::Baseline:
+            return of<IsaLevel::Baseline>();
+#if BENCHMARK_SUITE_ISA_DISPATCH
+        case IsaLevel::X86_64_V2:
+            return of<IsaLevel::X86_64_V2>();
+        case IsaLevel::X86_64_V3:
+            return of<IsaLevel::X86_64_V3>();
+        case IsaLevel::X86_64_V4:
+            return of<IsaLevel::X86_64_V4>();
+#endif
+        default:
+            throw std::runtime_error("FMA kernels were not compiled for this ISA level!");
+        }
+    }
+};
+
+// The STREAM kernels, a[i] = b[i] + scalar * c[i] and so on
+enum class StreamKernel
+{
+    Copy,
+    Scale,
+    Add,
+    Triad,
+};
+
+// Measures the ceilings of the roofline model and records them with --roofline=<file> for the other suites: the
+// bandwidth of the STREAM kernels in every memory level on one and on all cores, the peak flop/s of scalar and SIMD
+// multiply adds per ISA level on one core, and the load latency over working sets from 1 KiB to 4 GiB, from which the
+// capacities of the caches and the reach of the TLB are detected.
+class MachineCeilings : public benchmark::Fixture
+{
+public:
+    void SetUp(::benchmark::State& state)
+    {
+        MemoryTracker::beginRun(state);
+    }
+
+    void TearDown(::benchmark::State& state)
+    {
+        MemoryTracker::endRun(state);
+        ThreadPlacement::unplaceTeam();
+    }
+
+    // Memory levels as first argument, one and all cores as second argument
+    static void memoryLevelsAndCores(benchmark::internal::Benchmark* benchmark)
+    {
+        auto cores = std::vector<int64_t>{1};
+        if (CpuTopology::get().numCores() > 1)
+        {
+            cores.push_back(CpuTopology::get().numCores());
+        }
+
+        benchmark->ArgNames({"level", "cores"});
+        benchmark->ArgsProduct({
+            benchmark::CreateDenseRange(0, static_cast<int>(Roofline::memoryLevels().size()) - 1,
+                                        /*step=*/1), // Memory level
+            cores,                                   // Number of cores
+        });
+    }
+
+protected:
+    static constexpr double scalar = 3.0;
+
+    // Each thread moves at least this much per iteration, to keep the cost of starting the threads out of the timing
+    static constexpr size_t minBytesPerIteration = size_t{4} << 20;
+
+    static void RunStream(benchmark::State& state, StreamKernel kernel, const std::string& name)
+    {
+        const auto& level = Roofline::memoryLevels().at(state.range(0));
+        const int numOfCores = state.range(1);
+        state.SetLabel(level);
+
+        // Bytes read and written per element, without the write allocate traffic, as STREAM counts them
+        const size_t bytesPerElement = (kernel == StreamKernel::Copy || kernel == StreamKernel::Scale ? 2 : 3) *
+                                       sizeof(double);
+        const size_t size = arraySizeFor(level, numOfCores);
+        const size_t numOfSweeps = std::max<size_t>(1, minBytesPerIteration / (size * bytesPerElement));
+
+        // Every thread touches its own arrays first, so that they are local to its core
+        auto arrays = std::vector<std::vector<double>>(3 * numOfCores);
+        ThreadPlacement::placeTeam(ThreadPlacement::Policy::PhysicalCores, numOfCores);
+#pragma omp parallel num_threads(numOfCores)
+        {
+            const int thread = omp_get_thread_num();
+            arrays[3 * thread] = std::vector<double>(size, 1.0);
+            arrays[3 * thread + 1] = std::vector<double>(size, 2.0);
+            arrays[3 * thread + 2] = std::vector<double>(size, 0.0);
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+        {
+#pragma omp parallel num_threads(numOfCores)
+            {
+                const int thread = omp_get_thread_num();
+                double* a = arrays[3 * thread].data();
+                double* b = arrays[3 * thread + 1].data();
+                double* c = arrays[3 * thread + 2].data();
+                for (size_t sweep = 0; sweep < numOfSweeps; sweep++)
+                {
+                    sweepStream(kernel, a, b, c, size);
+                    benchmark::ClobberMemory();
+                }
+            }
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto bytes = static_cast<double>(state.iterations() * numOfSweeps * size * bytesPerElement * numOfCores);
+        state.SetBytesProcessed(static_cast<int64_t>(bytes));
+        Roofline::record(Roofline::bandwidthKey(name, level, numOfCores > 1), bytes / seconds);
+    }
+
+    static void RunFma(benchmark::State& state, bool simd)
+    {
+        const auto kernels = kernelsFor(state);
+        if (!kernels)
+        {
+            return;
+        }
+
+        // The accumulators converge to addend / (1 - factor) without overflows or denormals
+        const int64_t repetitions = 1 << 20;
+        const double factor = 0.999999;
+        const double addend = 1e-6;
+        const double flopsPerIteration = 2.0 * repetitions * FmaKernels<IsaLevel::Baseline>::numOfChains *
+                                         (simd ? kernels->simdLanes() : 1);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (auto _ : state)
+        {
+            auto result =
+                simd ? kernels->simd(repetitions, factor, addend) : kernels->scalar(repetitions, factor, addend);
+            benchmark::DoNotOptimize(result);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const double flops = flopsPerIteration * static_cast<double>(state.iterations());
+        state.counters["flops"] = benchmark::Counter(flops, benchmark::Counter::kIsRate);
+        Roofline::record(Roofline::flopsKey(static_cast<IsaLevel>(state.range(0)), simd), flops / seconds);
+    }
+
+private:
+    // Doubles per array and thread, so that the three arrays of all threads fill half of a cache level, or four times
+    // the last cache level for dram. Only the last cache level is taken to be shared between cores.
+    static size_t arraySizeFor(const std::string& level, int numOfCores)
+    {
+        const auto& levels = Roofline::memoryLevels();
+        const auto& lastCacheLevel = levels.size() > 1 ? levels[levels.size() - 2] : level;
+        const size_t lastCacheBytes = std::max<size_t>(Roofline::capacityOf(lastCacheLevel), size_t{16} << 20);
+
+        size_t bytes = level == "dram" ? 4 * lastCacheBytes : Roofline::capacityOf(level) / 2;
+        if (level == "dram" || level == lastCacheLevel)
+        {
+            bytes /= numOfCores;
+        }
+        return std::max<size_t>(bytes / (3 * sizeof(double)), 64);
+    }
+
+    static void sweepStream(StreamKernel kernel, double* a, double* b, double* c, size_t size)
+    {
+        switch (kernel)
+        {
+        case StreamKernel::Copy:
+            for (size_t i = 0; i < size; i++)
+            {
+                c[i] = a[i];
+            }
+            break;
+        case StreamKernel::Scale:
+            for (size_t i = 0; i < size; i++)
+            {
+                b[i] = scalar * c[i];
+            }
+            break;
+        case StreamKernel::Add:
+            for (size_t i = 0; i < size; i++)
+            {
+                c[i] = a[i] + b[i];
+            }
+            break;
+        case StreamKernel::Triad:
+            for (size_t i = 0; i < size; i++)
+            {
+                a[i] = b[i] + scalar * c[i];
+            }
+            break;
+        }
+    }
+
+    // Kernels of the ISA level given as first argument, none after skipping when the cpu does not support it
+    static std::optional<FmaKernelTable> kernelsFor(benchmark::State& state)
+    {
+        const auto level = static_cast<IsaLevel>(state.range(0));
+        state.SetLabel(IsaSupport::name(level));
+        if (!IsaSupport::isSupported(level))
+        {
+            state.SkipWithError("ISA level not supported by this cpu or build");
+            return std::nullopt;
+        }
+
+        return FmaKernelTable::forIsa(level);
+    }
+};
+
+BENCHMARK_DEFINE_F(MachineCeilings, StreamCopy)(benchmark::State& state)
+{
+    RunStream(state, StreamKernel::Copy, "copy");
+}
+BENCHMARK_REGISTER_F(MachineCeilings, StreamCopy)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(MachineCeilings::memoryLevelsAndCores);
+
+BENCHMARK_DEFINE_F(MachineCeilings, StreamScale)(benchmark::State& state)
+{
+    RunStream(state, StreamKernel::Scale, "scale");
+}
+BENCHMARK_REGISTER_F(MachineCeilings, StreamScale)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(MachineCeilings::memoryLevelsAndCores);
+
+BENCHMARK_DEFINE_F(MachineCeilings, StreamAdd)(benchmark::State& state)
+{
+    RunStream(state, StreamKernel::Add, "add");
+}
+BENCHMARK_REGISTER_F(MachineCeilings, StreamAdd)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(MachineCeilings::memoryLevelsAndCores);
+
+BENCHMARK_DEFINE_F(MachineCeilings, StreamTriad)(benchmark::State& state)
+{
+    RunStream(state, StreamKernel::Triad, "triad");
+}
+BENCHMARK_REGISTER_F(MachineCeilings, StreamTriad)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime()
+    ->Apply(MachineCeilings::memoryLevelsAndCores);
+
+BENCHMARK_DEFINE_F(MachineCeilings, ScalarFma)(benchmark::State& state)
+{
+    RunFma(state, /*simd=*/false);
+}
+BENCHMARK_REGISTER_F(MachineCeilings, ScalarFma)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4))
+    ->ArgNames({"isa"});
+
+BENCHMARK_DEFINE_F(MachineCeilings, SimdFma)(benchmark::State& state)
+{
+    RunFma(state, /*simd=*/true);
+}
+BENCHMARK_REGISTER_F(MachineCeilings, SimdFma)
+    ->Unit(benchmark::kMicrosecond)
+    ->DenseRange(static_cast<int>(IsaLevel::Baseline), static_cast<int>(IsaLevel::X86_64_V4))
+    ->ArgNames({"isa"});
+
+BENCHMARK_DEFINE_F(MachineCeilings, PointerChase)(benchmark::State& state)
+{
+    const size_t workingSetBytes = state.range(0);
+    const auto pattern = static_cast<PointerChase::Pattern>(state.range(1));
+    state.SetLabel(PointerChase::name(pattern));
+
+    const size_t physicalMemoryBytes = sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGESIZE);
+    if (workingSetBytes > physicalMemoryBytes / 2)
+    {
+        state.SkipWithError("Working set larger than half of the physical memory");
+        return;
+    }
+
+    auto chase = PointerChase(workingSetBytes, pattern);
+    const int64_t loadsPerIteration = 1 << 20;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        chase.chase(loadsPerIteration);
+        benchmark::DoNotOptimize(chase.position());
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    state.counters["latency"] = benchmark::Counter(
+        loadsPerIteration, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    const auto numOfLoads = static_cast<double>(state.iterations() * loadsPerIteration);
+    Roofline::recordLatency(PointerChase::name(pattern), workingSetBytes, seconds / numOfLoads);
+}
+BENCHMARK_REGISTER_F(MachineCeilings, PointerChase)
+    ->Unit(benchmark::kMicrosecond)
+    ->ArgNames({"bytes", "pattern"})
+    ->ArgsProduct({
+        benchmark::CreateRange(1 << 10, int64_t{4} << 30, /*multiplier=*/2), // Working set
+        {static_cast<int>(PointerChase::Pattern::Random), static_cast<int>(PointerChase::Pattern::Strided)},
+    });
+
+SUITE_MAIN();
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <omp.h>
+
+#include "Common/Matrix2D.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Jacobi sweeps of a 5 point or 9 point stencil over a square grid: every timestep replaces each cell with the average
+// of itself and its 4 direct or all 8 neighbours in the timestep before. The outermost rows and columns are a fixed
+// boundary that is never updated and has to be the same in both grids. Every variant takes turns writing the two grids
+// and returns the one that holds the last timestep.
+template <int Points>
+class Stencil
+{
+    static_assert(Points == 5 || Points == 9, "Only 5 and 9 point stencils are supported");
+
+public:
+    // Cells [firstX, lastX) of a row from the rows above and below it in the timestep before
+    static void updateRow(const double* above, const double* row, const double* below, double* out, size_t firstX,
+                          size_t lastX)
+    {
+        for (size_t x = firstX; x < lastX; x++)
+        {
+            if constexpr (Points == 5)
+            {
+                out[x] = 0.2 * (row[x] + row[x - 1] + row[x + 1] + above[x] + below[x]);
+            }
+            else
+            {
+                out[x] = (1.0 / 9.0) * (above[x - 1] + above[x] + above[x + 1] + row[x - 1] + row[x] + row[x + 1] +
+                                        below[x - 1] + below[x] + below[x + 1]);
+            }
+        }
+    }
+
+    // One sweep over the whole grid per timestep, with the rows split among the threads
+    static Matrix2D<double>* naive(Matrix2D<double>& grid, Matrix2D<double>& next, int numOfSteps, int numOfThreads)
+    {
+        const size_t width = grid.width();
+        const size_t height = grid.height();
+        auto* from = &grid;
+        auto* to = &next;
+        for (int step = 0; step < numOfSteps; step++)
+        {
+            const double* in = from->data();
+            double* out = to->data();
+#pragma omp parallel for num_threads(numOfThreads) schedule(static)
+            for (size_t y = 1; y < height - 1; y++)
+            {
+                updateRow(in + (y - 1) * width, in + y * width, in + (y + 1) * width, out + y * width, 1, width - 1);
+            }
+            std::swap(from, to);
+        }
+        return from;
+    }
+
+    // One sweep per timestep in square tiles of tileSize cells, split among the threads, so that the rows above and
+    // below the row of a tile are still cached when it is computed, even if whole rows no longer fit
+    static Matrix2D<double>* tiled(Matrix2D<double>& grid, Matrix2D<double>& next, int numOfSteps, int numOfThreads,
+                                   size_t tileSize)
+    {
+        const size_t width = grid.width();
+        const size_t height = grid.height();
+        const size_t numOfTilesX = (width - 2 + tileSize - 1) / tileSize;
+        const size_t numOfTilesY = (height - 2 + tileSize - 1) / tileSize;
+        auto* from = &grid;
+        auto* to = &next;
+        for (int step = 0; step < numOfSteps; step++)
+        {
+            const double* in = from->data();
+            double* out = to->data();
+#pragma omp parallel for num_threads(numOfThreads) schedule(static) collapse(2)
+            for (size_t tileY = 0; tileY < numOfTilesY; tileY++)
+            {
+                for (size_t tileX = 0; tileX < numOfTilesX; tileX++)
+                {
+                    const size_t firstX = 1 + tileX * tileSize;
+                    const size_t lastX = std::min(firstX + tileSize, width - 1);
+                    const size_t firstY = 1 + tileY * tileSize;
+                    const size_t lastY = std::min(firstY + tileSize, height - 1);
+                    for (size_t y = firstY; y < lastY; y++)
+                    {
+                        updateRow(in + (y - 1) * width, in + y * width, in + (y + 1) * width, out + y * width, firstX,
+                                  lastX);
+                    }
+                }
+            }
+            std::swap(from, to);
+        }
+        return from;
+    }
+
+    // Temporal blocking with overlapped bands: every thread copies its band of rows, widened by depth rows on both
+    // sides, into two buffers of its own and advances it there by depth timesteps before writing the band back. Each
+    // timestep leaves one more of the outer rows stale, so after depth timesteps exactly the band is valid. The
+    // outer rows are computed by the neighbouring threads as well, which is the price for synchronizing only once
+    // per depth timesteps instead of once per timestep.
+    static Matrix2D<double>* overlapped(Matrix2D<double>& grid, Matrix2D<double>& next, int numOfSteps,
+                                        int numOfThreads, int depth)
+    {
+        const size_t width = grid.width();
+        const size_t height = grid.height();
+        auto buffers = std::vector<std::vector<double>>(2 * numOfThreads);
+        auto* from = &grid;
+        auto* to = &next;
+        for (int step = 0; step < numOfSteps; step += depth)
+        {
+            const size_t numOfBlockSteps = std::min(depth, numOfSteps - step);
+#pragma omp parallel num_threads(numOfThreads)
+            {
+                const int thread = omp_get_thread_num();
+                const int numOfBands = omp_get_num_threads();
+                const size_t firstY = 1 + (height - 2) * thread / numOfBands;
+                const size_t lastY = 1 + (height - 2) * (thread + 1) / numOfBands;
+
+                // Rows [low, high) of the grid are kept in the buffers, including the boundary rows where they reach
+                const size_t low = firstY - std::min(firstY, numOfBlockSteps);
+                const size_t high = std::min(lastY + numOfBlockSteps, height);
+                auto& in = buffers[2 * thread];
+                auto& out = buffers[2 * thread + 1];
+                in.assign(from->data() + low * width, from->data() + high * width);
+                out = in;
+
+                for (size_t blockStep = 0; blockStep < numOfBlockSteps; blockStep++)
+                {
+                    const size_t fromY = low == 0 ? 1 : low + 1 + blockStep;
+                    const size_t toY = high == height ? height - 1 : high - 1 - blockStep;
+                    for (size_t y = fromY; y < toY; y++)
+                    {
+                        const double* row = in.data() + (y - low) * width;
+                        updateRow(row - width, row, row + width, out.data() + (y - low) * width, 1, width - 1);
+                    }
+                    std::swap(in, out);
+                }
+                std::copy(in.data() + (firstY - low) * width, in.data() + (lastY - low) * width,
+                          to->data() + firstY * width);
+            }
+            std::swap(from, to);
+        }
+        return from;
+    }
+
+    // Temporal blocking as a pipelined wavefront: in every pass each thread advances the whole grid by one timestep,
+    // row after row, right behind the thread of the timestep before, so that the rows it reads are still in a shared
+    // cache level. A thread computes a row only when the thread before has finished the row below it, which also makes
+    // sure that nobody still reads the row it overwrites.
+    static Matrix2D<double>* wavefront(Matrix2D<double>& grid, Matrix2D<double>& next, int numOfSteps,
+                                       int numOfThreads)
+    {
+        const size_t width = grid.width();
+        const size_t height = grid.height();
+        Matrix2D<double>* grids[] = {&grid, &next};
+        auto progress = std::make_unique<std::atomic<size_t>[]>(numOfThreads);
+        for (int step = 0; step < numOfSteps; step += numOfThreads)
+        {
+            const int numOfStages = std::min(numOfThreads, numOfSteps - step);
+            for (int stage = 0; stage < numOfStages; stage++)
+            {
+                progress[stage].store(0, std::memory_order_relaxed);
+            }
+
+#pragma omp parallel num_threads(numOfStages)
+            {
+                const int stage = omp_get_thread_num();
+                const double* in = grids[(step + stage) % 2]->data();
+                double* out = grids[(step + stage + 1) % 2]->data();
+                for (size_t y = 1; y < height - 1; y++)
+                {
+                    if (stage > 0)
+                    {
+                        const size_t needed = std::min(y + 1, height - 2);
+                        while (progress[stage - 1].load(std::memory_order_acquire) < needed)
+                        {
+                            std::this_thread::yield();
+                        }
+                    }
+                    updateRow(in + (y - 1) * width, in + y * width, in + (y + 1) * width, out + y * width, 1,
+                              width - 1);
+                    progress[stage].store(y, std::memory_order_release);
+                }
+            }
+        }
+        return grids[numOfSteps % 2];
+    }
+};
@@ -0,0 +1,154 @@
+#include <benchmark/benchmark.h>
+#include <omp.h>
+
+#include "Common/Matrix2D.h"
+#include "Common/MemoryTracker.h"
+#include "Common/ProfilingRegion.h"
+#include "Common/SuiteMain.h"
+#include "Common/ThreadPlacement.h"
+
+#include "Stencil.h"
+
+#include <utility>
+
+// Jacobi sweeps of 5 and 9 point stencils, naive, spatially tiled and temporally blocked, reported as cell updates
+// per second over the grid size and the number of timesteps per iteration
+class StencilSweeps : public benchmark::Fixture
+{
+public:
+    void SetUp(::benchmark::State& state)
+    {
+        MemoryTracker::beginRun(state);
+    }
+
+    void TearDown(::benchmark::State& state)
+    {
+        MemoryTracker::endRun(state);
+        ThreadPlacement::unplaceTeam();
+    }
+
+protected:
+    // Runs the sweep with the stencil of the first argument on a grid of the second argument squared interior cells for
+    // the timesteps of the third argument with the threads of the fourth argument. Every iteration continues from the
+    // timestep the one before ended with. The sweep gets a default constructed Stencil<5> or Stencil<9> to select its
+    // variant from.
+    template <typename Sweep>
+    static void Run(benchmark::State& state, Sweep sweep)
+    {
+        const int numOfPoints = state.range(0);
+        const size_t size = state.range(1);
+        const int numOfSteps = state.range(2);
+        const int numOfThreads = state.range(3);
+        // Next to each other, so that the wavefront threads share as much cache as possible
+        ThreadPlacement::placeTeam(ThreadPlacement::Policy::Compact, numOfThreads);
+
+        auto grid = makeGrid(size);
+        auto next = grid;
+        Matrix2D<double>* current = &grid;
+        Matrix2D<double>* other = &next;
+
+        const auto profilingRegion = ProfilingRegion();
+        for (auto _ : state)
+        {
+            Matrix2D<double>* result = numOfPoints == 5
+                                           ? sweep(Stencil<5>(), *current, *other, numOfSteps, numOfThreads)
+                                           : sweep(Stencil<9>(), *current, *other, numOfSteps, numOfThreads);
+            if (result != current)
+            {
+                std::swap(current, other);
+            }
+            benchmark::DoNotOptimize(current->data());
+            benchmark::ClobberMemory();
+        }
+
+        state.counters["updates"] = benchmark::Counter(static_cast<double>(size * size * numOfSteps),
+                                                       benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+private:
+    // Interior cells start at 0 and the top boundary row at 1, so that the heat spreads down from there
+    static Matrix2D<double> makeGrid(size_t size)
+    {
+        auto grid = Matrix2D<double>::filled(size + 2, size + 2, 0.0);
+        for (size_t x = 0; x < grid.width(); x++)
+        {
+            grid.setElem(x, 0, 1.0);
+        }
+        return grid;
+    }
+};
+
+BENCHMARK_DEFINE_F(StencilSweeps, Naive)(benchmark::State& state)
+{
+    Run(state, [](auto stencil, auto& grid, auto& next, int numOfSteps, int numOfThreads) {
+        return decltype(stencil)::naive(grid, next, numOfSteps, numOfThreads);
+    });
+}
+BENCHMARK_REGISTER_F(StencilSweeps, Naive)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({
+        {5, 9},                                              // Points of the stencil
+        benchmark::CreateRange(256, 8192, /*multiplier=*/4), // Interior cells per side of the grid
+        {4, 32},                                             // Timesteps per iteration
+        {1, 4},                                              // Number of threads
+    })
+    ->ArgNames({"points", "grid", "steps", "threads"});
+
+BENCHMARK_DEFINE_F(StencilSweeps, Tiled)(benchmark::State& state)
+{
+    const size_t tileSize = state.range(4);
+    Run(state, [tileSize](auto stencil, auto& grid, auto& next, int numOfSteps, int numOfThreads) {
+        return decltype(stencil)::tiled(grid, next, numOfSteps, numOfThreads, tileSize);
+    });
+}
+BENCHMARK_REGISTER_F(StencilSweeps, Tiled)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({
+        {5, 9},                                              // Points of the stencil
+        benchmark::CreateRange(256, 8192, /*multiplier=*/4), // Interior cells per side of the grid
+        {4, 32},                                             // Timesteps per iteration
+        {1, 4},                                              // Number of threads
+        {32, 256},                                           // Cells per side of a tile
+    })
+    ->ArgNames({"points", "grid", "steps", "threads", "tile"});
+
+BENCHMARK_DEFINE_F(StencilSweeps, Overlapped)(benchmark::State& state)
+{
+    const int depth = state.range(4);
+    Run(state, [depth](auto stencil, auto& grid, auto& next, int numOfSteps, int numOfThreads) {
+        return decltype(stencil)::overlapped(grid, next, numOfSteps, numOfThreads, depth);
+    });
+}
+BENCHMARK_REGISTER_F(StencilSweeps, Overlapped)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({
+        {5, 9},                                              // Points of the stencil
+        benchmark::CreateRange(256, 8192, /*multiplier=*/4), // Interior cells per side of the grid
+        {4, 32},                                             // Timesteps per iteration
+        {1, 4},                                              // Number of threads
+        {4, 16},                                             // Timesteps per block
+    })
+    ->ArgNames({"points", "grid", "steps", "threads", "depth"});
+
+// Timesteps per pass of the wavefront are the number of threads
+BENCHMARK_DEFINE_F(StencilSweeps, Wavefront)(benchmark::State& state)
+{
+    Run(state, [](auto stencil, auto& grid, auto& next, int numOfSteps, int numOfThreads) {
+        return decltype(stencil)::wavefront(grid, next, numOfSteps, numOfThreads);
+    });
+}
+BENCHMARK_REGISTER_F(StencilSweeps, Wavefront)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->ArgsProduct({
+        {5, 9},                                              // Points of the stencil
+        benchmark::CreateRange(256, 8192, /*multiplier=*/4), // Interior cells per side of the grid
+        {4, 32},                                             // Timesteps per iteration
+        {1, 4},                                              // Number of threads
+    })
+    ->ArgNames({"points", "grid", "steps", "threads"});
+
+SUITE_MAIN();
@@ -0,0 +1,43 @@
+#include "Common/CommandLine.h"
+
+#include <string_view>
+
+std::optional<std::string> CommandLine::extractFlag(int& argc, char** argv, const std::string& name)
+{
+    const auto prefix = "--" + name + "=";
+    std::optional<std::string> value;
+
+    int kept = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        const auto argument = std::string_view(argv[i]);
+        if (i > 0 && argument.starts_with(prefix))
+        {
+            value = std::string(argument.substr(prefix.size()));
+        }
+        else
+        {
+            argv[kept++] = argv[i];
+        }
+    }
+
+    argc = kept;
+    return value;
+}
+
+std::optional<std::string> CommandLine::findFlag(int argc, char** argv, const std::string& name)
+{
+    const auto prefix = "--" + name + "=";
+    std::optional<std::string> value;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const auto argument = std::string_view(argv[i]);
+        if (argument.starts_with(prefix))
+        {
+            value = std::string(argument.substr(prefix.size()));
+        }
+    }
+
+    return value;
+}
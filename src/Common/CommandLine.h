@@ -0,0 +1,15 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+class CommandLine
+{
+public:
+    // Removes every '--name=value' occurrence from the arguments and returns the last value, so that our own flags
+    // are gone before the remaining arguments are handed to Google Benchmark.
+    static std::optional<std::string> extractFlag(int& argc, char** argv, const std::string& name);
+
+    // Returns the last value of '--name=value' without removing it, for flags that Google Benchmark parses itself
+    static std::optional<std::string> findFlag(int argc, char** argv, const std::string& name);
+};
@@ -0,0 +1,249 @@
+#include "Common/CpuTopology.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+
+namespace
+{
+// Plain strings, so that the topology can be read while benchmarks are registered during static initialization
+constexpr auto cpuRoot = "/sys/devices/system/cpu";
+constexpr auto nodeRoot = "/sys/devices/system/node";
+
+std::string readLine(const std::filesystem::path& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+int readInt(const std::filesystem::path& path, int fallback)
+{
+    try
+    {
+        return std::stoi(readLine(path));
+    }
+    catch (const std::exception&)
+    {
+        return fallback;
+    }
+}
+
+// Parses sizes such as "48K" or "2048K"
+size_t parseSize(const std::string& size)
+{
+    if (size.empty())
+    {
+        return 0;
+    }
+
+    size_t multiplier = 1;
+    switch (size.back())
+    {
+    case 'K':
+        multiplier = size_t(1) << 10;
+        break;
+    case 'M':
+        multiplier = size_t(1) << 20;
+        break;
+    case 'G':
+        multiplier = size_t(1) << 30;
+        break;
+    }
+    return std::stoull(size) * multiplier;
+}
+
+// Cpus sharing an L3 cache report the same cache id, fall back to the package if there is no L3
+int readL3Id(const std::filesystem::path& cpu, int packageId)
+{
+    for (int index = 0;; index++)
+    {
+        const auto cache = cpu / "cache" / ("index" + std::to_string(index));
+        if (!std::filesystem::exists(cache))
+        {
+            return packageId;
+        }
+        if (readInt(cache / "level", 0) == 3)
+        {
+            const auto sharedCpus = CpuTopology::parseCpuList(readLine(cache / "shared_cpu_list"));
+            return readInt(cache / "id", sharedCpus.empty() ? packageId : sharedCpus.front());
+        }
+    }
+}
+
+std::string formatSize(size_t bytes)
+{
+    if (bytes >= (size_t(1) << 20) && bytes % (size_t(1) << 20) == 0)
+    {
+        return std::to_string(bytes >> 20) + "M";
+    }
+    return std::to_string(bytes >> 10) + "K";
+}
+} // namespace
+
+const CpuTopology& CpuTopology::get()
+{
+    static const CpuTopology topology;
+    return topology;
+}
+
+std::vector<int> CpuTopology::parseCpuList(const std::string& cpuList)
+{
+    std::vector<int> cpus;
+    std::istringstream iss(cpuList);
+    std::string range;
+    while (std::getline(iss, range, ','))
+    {
+        if (range.empty())
+        {
+            continue;
+        }
+
+        const auto dash = range.find('-');
+        const int first = std::stoi(range.substr(0, dash));
+        const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+std::string CpuTopology::formatCpuList(const std::vector<int>& cpus)
+{
+    std::ostringstream oss;
+    for (size_t i = 0; i < cpus.size(); i++)
+    {
+        size_t last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+        {
+            last++;
+        }
+
+        oss << (i == 0 ? "" : ",") << cpus[i];
+        if (last > i)
+        {
+            oss << "-" << cpus[last];
+        }
+        i = last;
+    }
+    return oss.str();
+}
+
+CpuTopology::CpuTopology()
+{
+    auto numaNodeOfCpu = std::map<int, int>();
+    for (int node = 0; std::filesystem::exists(std::filesystem::path(nodeRoot) / ("node" + std::to_string(node)));
+         node++)
+    {
+        const auto nodePath = std::filesystem::path(nodeRoot) / ("node" + std::to_string(node));
+        for (const int cpu : parseCpuList(readLine(nodePath / "cpulist")))
+        {
+            numaNodeOfCpu[cpu] = node;
+        }
+    }
+
+    for (const int id : parseCpuList(readLine(std::filesystem::path(cpuRoot) / "online")))
+    {
+        const auto cpu = std::filesystem::path(cpuRoot) / ("cpu" + std::to_string(id));
+        const int packageId = readInt(cpu / "topology" / "physical_package_id", 0);
+        const auto siblings = parseCpuList(readLine(cpu / "topology" / "thread_siblings_list"));
+        const auto smtIndex = std::find(siblings.begin(), siblings.end(), id) - siblings.begin();
+
+        cpus_.push_back({
+            .id = id,
+            .coreId = readInt(cpu / "topology" / "core_id", id),
+            .packageId = packageId,
+            .numaNode = numaNodeOfCpu.contains(id) ? numaNodeOfCpu[id] : 0,
+            .l3Id = readL3Id(cpu, packageId),
+            .smtIndex = smtIndex < static_cast<long>(siblings.size()) ? static_cast<int>(smtIndex) : 0,
+        });
+    }
+
+    for (int index = 0;; index++)
+    {
+        const auto cache = std::filesystem::path(cpuRoot) / "cpu0" / "cache" / ("index" + std::to_string(index));
+        if (!std::filesystem::exists(cache))
+        {
+            break;
+        }
+        caches_.push_back({
+            .level = readInt(cache / "level", 0),
+            .type = readLine(cache / "type"),
+            .sizeBytes = parseSize(readLine(cache / "size")),
+        });
+    }
+
+    isolatedCpus_ = parseCpuList(readLine(std::filesystem::path(cpuRoot) / "isolated"));
+}
+
+int CpuTopology::numPackages() const
+{
+    auto packages = std::set<int>();
+    for (const auto& cpu : cpus_)
+    {
+        packages.insert(cpu.packageId);
+    }
+    return packages.size();
+}
+
+int CpuTopology::numCores() const
+{
+    auto cores = std::set<std::pair<int, int>>();
+    for (const auto& cpu : cpus_)
+    {
+        cores.insert({cpu.packageId, cpu.coreId});
+    }
+    return cores.size();
+}
+
+int CpuTopology::numNumaNodes() const
+{
+    auto nodes = std::set<int>();
+    for (const auto& cpu : cpus_)
+    {
+        nodes.insert(cpu.numaNode);
+    }
+    return nodes.size();
+}
+
+std::string CpuTopology::describeSmt() const
+{
+    const int cores = std::max(numCores(), 1);
+    std::ostringstream oss;
+    oss << numPackages() << " package(s), " << cores << " core(s), " << cpus_.size() / cores << " thread(s) per core, smt "
+        << readLine(std::filesystem::path(cpuRoot) / "smt" / "control");
+    return oss.str();
+}
+
+std::string CpuTopology::describeNuma() const
+{
+    auto cpusOfNode = std::map<int, std::vector<int>>();
+    for (const auto& cpu : cpus_)
+    {
+        cpusOfNode[cpu.numaNode].push_back(cpu.id);
+    }
+
+    std::ostringstream oss;
+    for (const auto& [node, cpus] : cpusOfNode)
+    {
+        oss << (oss.tellp() > 0 ? " " : "") << "node" << node << ":" << formatCpuList(cpus);
+    }
+    return oss.str();
+}
+
+std::string CpuTopology::describeCaches() const
+{
+    std::ostringstream oss;
+    for (const auto& cache : caches_)
+    {
+        const auto suffix = cache.type == "Data" ? "d" : cache.type == "Instruction" ? "i" : "";
+        oss << (oss.tellp() > 0 ? " " : "") << "L" << cache.level << suffix << ":" << formatSize(cache.sizeBytes);
+    }
+    return oss.str();
+}
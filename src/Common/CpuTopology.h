@@ -0,0 +1,62 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+// CPU, cache and NUMA layout of the machine as described by /sys/devices/system.
+class CpuTopology
+{
+public:
+    struct Cpu
+    {
+        int id;
+        int coreId;
+        int packageId;
+        int numaNode;
+        int l3Id;      // cpus with the same id share an L3 cache
+        int smtIndex;  // position of the cpu among the hardware threads of its core
+    };
+
+    struct Cache
+    {
+        int level;
+        std::string type;
+        size_t sizeBytes;
+    };
+
+    static const CpuTopology& get();
+
+    // Parses the kernel's cpu list format, e.g. "0-3,8,10-11"
+    static std::vector<int> parseCpuList(const std::string& cpuList);
+    static std::string formatCpuList(const std::vector<int>& cpus);
+
+    const std::vector<Cpu>& cpus() const
+    {
+        return cpus_;
+    }
+
+    const std::vector<Cache>& caches() const
+    {
+        return caches_;
+    }
+
+    const std::vector<int>& isolatedCpus() const
+    {
+        return isolatedCpus_;
+    }
+
+    int numPackages() const;
+    int numCores() const;
+    int numNumaNodes() const;
+
+    std::string describeSmt() const;
+    std::string describeNuma() const;
+    std::string describeCaches() const;
+
+private:
+    CpuTopology();
+
+    std::vector<Cpu> cpus_;
+    std::vector<Cache> caches_;
+    std::vector<int> isolatedCpus_;
+};
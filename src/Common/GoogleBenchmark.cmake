@@ -0,0 +1,57 @@
+# Provides benchmark::benchmark without needing network access, from the first source that is available:
+#   1. an installed Google Benchmark found with find_package
+#   2. a vendored copy in BENCHMARK_SUITE_VENDORED_BENCHMARK (default: <repo>/third_party/benchmark)
+#   3. a download from GitHub with FetchContent, unless BENCHMARK_SUITE_FETCH_BENCHMARK is off
+#
+# The benchmark library is always used in a release configuration, also in Debug builds of the suites, so that the
+# harness itself does not skew the timings. BENCHMARK_ENABLE_LTO builds it from source with link time optimization,
+# which skips an installed copy. BENCHMARK_SUITE_BENCHMARK_VERSION holds the version in use.
+
+option(BENCHMARK_ENABLE_LTO "Build Google Benchmark from source with link time optimization" OFF)
+option(BENCHMARK_SUITE_FETCH_BENCHMARK "Download Google Benchmark if neither an installed nor a vendored copy exists" ON)
+get_filename_component(defaultVendoredBenchmark ${CMAKE_CURRENT_LIST_DIR}/../../third_party/benchmark ABSOLUTE)
+set(BENCHMARK_SUITE_VENDORED_BENCHMARK ${defaultVendoredBenchmark} CACHE PATH "Vendored Google Benchmark source tree")
+
+if(NOT BENCHMARK_ENABLE_LTO)
+    find_package(benchmark QUIET)
+endif()
+
+if(benchmark_FOUND)
+    set(BENCHMARK_SUITE_BENCHMARK_VERSION ${benchmark_VERSION})
+    message(STATUS "Using installed Google Benchmark ${benchmark_VERSION}")
+
+    # Never pick a debug build of the library if the installation provides several configurations
+    set_target_properties(benchmark::benchmark PROPERTIES
+        MAP_IMPORTED_CONFIG_DEBUG "Release;RelWithDebInfo;MinSizeRel;None;"
+    )
+    return()
+endif()
+
+set(BENCHMARK_ENABLE_TESTING OFF)
+set(BENCHMARK_ENABLE_GTEST_TESTS OFF)
+set(BENCHMARK_ENABLE_INSTALL OFF)
+set(BENCHMARK_ENABLE_WERROR OFF)
+
+if(EXISTS ${BENCHMARK_SUITE_VENDORED_BENCHMARK}/CMakeLists.txt)
+    set(googleBenchmarkSource ${BENCHMARK_SUITE_VENDORED_BENCHMARK})
+    message(STATUS "Using vendored Google Benchmark from ${googleBenchmarkSource}")
+    add_subdirectory(${googleBenchmarkSource} ${CMAKE_BINARY_DIR}/_deps/googlebenchmark-build EXCLUDE_FROM_ALL)
+elseif(BENCHMARK_SUITE_FETCH_BENCHMARK)
+    message(STATUS "Google Benchmark is neither installed nor vendored, downloading it")
+    include(FetchContent)
+    FetchContent_Declare(googlebenchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG v1.8.5
+    )
+    FetchContent_MakeAvailable(googlebenchmark)
+    set(googleBenchmarkSource ${googlebenchmark_SOURCE_DIR})
+else()
+    message(FATAL_ERROR "Google Benchmark not found: install it, vendor it into ${BENCHMARK_SUITE_VENDORED_BENCHMARK} "
+        "or enable BENCHMARK_SUITE_FETCH_BENCHMARK")
+endif()
+
+get_directory_property(BENCHMARK_SUITE_BENCHMARK_VERSION DIRECTORY ${googleBenchmarkSource} DEFINITION benchmark_VERSION)
+
+# Optimized without assertions in every configuration, like an installed release build
+target_compile_options(benchmark PRIVATE $<$<CONFIG:Debug>:-O2>)
+target_compile_definitions(benchmark PRIVATE $<$<CONFIG:Debug>:NDEBUG>)
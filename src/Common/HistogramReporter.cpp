@@ -0,0 +1,24 @@
+#include "Common/HistogramReporter.h"
+
+#include "Common/LatencyHistogram.h"
+
+HistogramReporter::HistogramReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter)
+    : displayReporter_(std::move(displayReporter))
+{
+}
+
+bool HistogramReporter::ReportContext(const Context& context)
+{
+    return displayReporter_->ReportContext(context);
+}
+
+void HistogramReporter::ReportRuns(const std::vector<Run>& reports)
+{
+    LatencyHistogram::writePublished(reports);
+    displayReporter_->ReportRuns(reports);
+}
+
+void HistogramReporter::Finalize()
+{
+    displayReporter_->Finalize();
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+// Forwards everything to the display reporter and writes the latency histograms that the reported runs published,
+// see LatencyHistogram
+class HistogramReporter : public benchmark::BenchmarkReporter
+{
+public:
+    explicit HistogramReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter);
+
+    bool ReportContext(const Context& context) override;
+    void ReportRuns(const std::vector<Run>& reports) override;
+    void Finalize() override;
+
+private:
+    std::unique_ptr<benchmark::BenchmarkReporter> displayReporter_;
+};
@@ -0,0 +1,66 @@
+#include "Common/IsaLevel.h"
+
+#include <stdexcept>
+
+const char* IsaSupport::name(IsaLevel level)
+{
+    switch (level)
+    {
+    case IsaLevel::Baseline:
+        return "baseline";
+    case IsaLevel::X86_64_V2:
+        return "x86-64-v2";
+    case IsaLevel::X86_64_V3:
+        return "x86-64-v3";
+    case IsaLevel::X86_64_V4:
+        return "x86-64-v4";
+    }
+    throw std::runtime_error("Unknown ISA level!");
+}
+
+bool IsaSupport::isCompiled(IsaLevel level)
+{
+    return level == IsaLevel::Baseline || BENCHMARK_SUITE_ISA_DISPATCH;
+}
+
+bool IsaSupport::isSupported(IsaLevel level)
+{
+    if (!isCompiled(level))
+    {
+        return false;
+    }
+
+#if BENCHMARK_SUITE_ISA_DISPATCH
+    // The levels as the compiler defines them for -march=x86-64-vN, which includes every feature that the code compiled
+    // for a level may use, such as cx16, lahf_lm, movbe, lzcnt and f16c besides the vector extensions
+    __builtin_cpu_init();
+    switch (level)
+    {
+    case IsaLevel::Baseline:
+        return true;
+    case IsaLevel::X86_64_V2:
+        return __builtin_cpu_supports("x86-64-v2");
+    case IsaLevel::X86_64_V3:
+        return __builtin_cpu_supports("x86-64-v3");
+    case IsaLevel::X86_64_V4:
+        return __builtin_cpu_supports("x86-64-v4");
+    }
+#endif
+
+    return level == IsaLevel::Baseline;
+}
+
+IsaLevel IsaSupport::best()
+{
+    static const auto level = [] {
+        for (const auto candidate : {IsaLevel::X86_64_V4, IsaLevel::X86_64_V3, IsaLevel::X86_64_V2})
+        {
+            if (isSupported(candidate))
+            {
+                return candidate;
+            }
+        }
+        return IsaLevel::Baseline;
+    }();
+    return level;
+}
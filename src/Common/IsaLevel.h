@@ -0,0 +1,26 @@
+#pragma once
+
+// x86-64 microarchitecture levels that hot kernels are compiled for, see add_isa_variants in IsaVariants.cmake
+enum class IsaLevel
+{
+    Baseline, // x86-64, or whatever the compiler targets by default on other architectures
+    X86_64_V2,
+    X86_64_V3,
+    X86_64_V4,
+};
+
+class IsaSupport
+{
+public:
+    static const char* name(IsaLevel level);
+
+    // Whether the kernels were compiled for the level, only the baseline is compiled off x86-64
+    static bool isCompiled(IsaLevel level);
+
+    // Whether the kernels of the level were compiled and can run on this cpu
+    static bool isSupported(IsaLevel level);
+
+    // Highest supported level, determined once at startup. Only the benchmarks that take their kernels from a kernel
+    // table for a level run code compiled for it, everything else runs baseline code.
+    static IsaLevel best();
+};
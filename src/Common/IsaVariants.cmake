@@ -0,0 +1,43 @@
+# Compiles hot kernels once per x86-64 microarchitecture level:
+#
+#   add_isa_variants(<target> <source>...)
+#
+# Every source is compiled into one object library per level, with ISA_LEVEL set to the value of the IsaLevel enum
+# and -march=x86-64-v2/v3/v4, and the objects are added to the target. The sources must only give external linkage to
+# explicit specializations on their IsaLevel (everything else in an anonymous namespace) and must not use inline
+# functions from headers, so that no differently compiled copy of a function can be picked by the linker.
+#
+# Off x86-64, or with compilers that do not know the levels, only the baseline is compiled and
+# BENCHMARK_SUITE_ISA_DISPATCH is 0.
+
+include(CheckCXXCompilerFlag)
+
+set(BENCHMARK_SUITE_ISA_DISPATCH OFF)
+if(CMAKE_SYSTEM_PROCESSOR MATCHES "^(x86_64|AMD64|amd64)$")
+    check_cxx_compiler_flag(-march=x86-64-v4 compilerSupportsIsaLevels)
+    if(compilerSupportsIsaLevels)
+        set(BENCHMARK_SUITE_ISA_DISPATCH ON)
+    endif()
+endif()
+
+
+function(add_isa_variants target)
+    if(BENCHMARK_SUITE_ISA_DISPATCH)
+        set(levels 0 1 2 3)
+    else()
+        set(levels 0)
+    endif()
+
+    # Level n > 0 is x86-64-v(n+1)
+    foreach(level ${levels})
+        set(variant ${target}_isa${level})
+        add_library(${variant} OBJECT ${ARGN})
+        target_compile_definitions(${variant} PRIVATE ISA_LEVEL=${level})
+        if(level GREATER 0)
+            math(EXPR march "${level} + 1")
+            target_compile_options(${variant} PRIVATE -march=x86-64-v${march})
+        endif()
+        target_link_libraries(${variant} PRIVATE Common)
+        target_sources(${target} PRIVATE $<TARGET_OBJECTS:${variant}>)
+    endforeach()
+endfunction()
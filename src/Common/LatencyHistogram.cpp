@@ -0,0 +1,188 @@
+#include "Common/LatencyHistogram.h"
+
+#include "Common/CommandLine.h"
+#include "Common/MemoryTracker.h"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+
+LatencyHistogram::LatencyHistogram(int precisionBits)
+    : precisionBits_(precisionBits)
+    , counts_((size_t{1} << precisionBits) + (64 - precisionBits) * (size_t{1} << (precisionBits - 1)))
+{
+    if (precisionBits < 2 || precisionBits > 16)
+    {
+        throw std::runtime_error("Latency histogram precision must be between 2 and 16 bits!");
+    }
+}
+
+void LatencyHistogram::parseArguments(int& argc, char** argv)
+{
+    if (const auto path = CommandLine::extractFlag(argc, argv, "latency_histogram_out"))
+    {
+        outputPath_ = *path;
+    }
+}
+
+// Values below 2^p are their own index. Above, the value is shifted right until it has p significant bits, the top
+// p-1 bits below the leading one select one of 2^(p-1) buckets per power of two.
+size_t LatencyHistogram::indexOf(int64_t value) const
+{
+    const auto unsignedValue = static_cast<uint64_t>(std::max<int64_t>(value, 0));
+    const size_t linearCount = size_t{1} << precisionBits_;
+    if (unsignedValue < linearCount)
+    {
+        return unsignedValue;
+    }
+
+    const int shift = std::bit_width(unsignedValue) - precisionBits_;
+    const size_t halfCount = linearCount / 2;
+    return linearCount + (shift - 1) * halfCount + ((unsignedValue >> shift) - halfCount);
+}
+
+int64_t LatencyHistogram::highestValueOf(size_t index) const
+{
+    const size_t linearCount = size_t{1} << precisionBits_;
+    if (index < linearCount)
+    {
+        return static_cast<int64_t>(index);
+    }
+
+    const size_t halfCount = linearCount / 2;
+    const int shift = static_cast<int>((index - linearCount) / halfCount) + 1;
+    const uint64_t significand = (index - linearCount) % halfCount + halfCount;
+    return static_cast<int64_t>(std::min<uint64_t>(((significand + 1) << shift) - 1, INT64_MAX));
+}
+
+void LatencyHistogram::record(int64_t nanoseconds)
+{
+    counts_[indexOf(nanoseconds)]++;
+    count_++;
+    min_ = std::min(min_, nanoseconds);
+    max_ = std::max(max_, nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    if (other.precisionBits_ != precisionBits_)
+    {
+        throw std::runtime_error("Latency histograms of different precision cannot be merged!");
+    }
+
+    for (size_t i = 0; i < counts_.size(); i++)
+    {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    min_ = INT64_MAX;
+    max_ = 0;
+}
+
+int64_t LatencyHistogram::count() const
+{
+    return count_;
+}
+
+int64_t LatencyHistogram::min() const
+{
+    return count_ ? min_ : 0;
+}
+
+int64_t LatencyHistogram::max() const
+{
+    return max_;
+}
+
+int64_t LatencyHistogram::quantile(double quantile) const
+{
+    if (count_ == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = std::max<int64_t>(1, static_cast<int64_t>(quantile * static_cast<double>(count_) + 0.5));
+    int64_t seen = 0;
+    for (size_t i = 0; i < counts_.size(); i++)
+    {
+        seen += counts_[i];
+        if (seen >= rank)
+        {
+            return std::min(highestValueOf(i), max_);
+        }
+    }
+    return max_;
+}
+
+void LatencyHistogram::publish(benchmark::State& state, const std::string& prefix) const
+{
+    if (state.thread_index() != 0)
+    {
+        return;
+    }
+
+    const auto pause = MemoryTracker::Pause();
+    const auto seconds = [](int64_t nanoseconds) { return static_cast<double>(nanoseconds) * 1e-9; };
+    state.counters[prefix + "p50"] = seconds(quantile(0.5));
+    state.counters[prefix + "p90"] = seconds(quantile(0.9));
+    state.counters[prefix + "p99"] = seconds(quantile(0.99));
+    state.counters[prefix + "max"] = seconds(max());
+
+    // The additional run that counts allocations is not reported on its own
+    if (!outputPath_.empty() && !MemoryTracker::measuring())
+    {
+        published_.push_back(*this);
+    }
+}
+
+void LatencyHistogram::writePublished(const std::vector<benchmark::BenchmarkReporter::Run>& runs)
+{
+    if (published_.empty())
+    {
+        return;
+    }
+
+    auto output = std::ofstream(outputPath_, outputStarted_ ? std::ios::app : std::ios::trunc);
+    if (!outputStarted_)
+    {
+        output << "benchmark,repetition,value_ns,count,cumulative_fraction\n";
+        outputStarted_ = true;
+    }
+
+    // The runs that estimate the number of iterations publish as well, they come before the reported ones
+    const auto numOfReported = static_cast<size_t>(
+        std::count_if(runs.begin(), runs.end(), [](const benchmark::BenchmarkReporter::Run& run)
+                      { return run.run_type == benchmark::BenchmarkReporter::Run::RT_Iteration; }));
+    size_t next = published_.size() - std::min(numOfReported, published_.size());
+    for (const auto& run : runs)
+    {
+        if (run.run_type != benchmark::BenchmarkReporter::Run::RT_Iteration || next == published_.size())
+        {
+            continue;
+        }
+
+        const auto& histogram = published_[next++];
+        int64_t seen = 0;
+        for (size_t i = 0; i < histogram.counts_.size(); i++)
+        {
+            if (histogram.counts_[i] == 0)
+            {
+                continue;
+            }
+            seen += histogram.counts_[i];
+            output << run.benchmark_name() << ',' << run.repetition_index << ',' << histogram.highestValueOf(i) << ','
+                   << histogram.counts_[i] << ',' << static_cast<double>(seen) / histogram.count_ << '\n';
+        }
+    }
+
+    published_.clear();
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Log-linear histogram of durations in nanoseconds in the style of HdrHistogram: exact below 2^precisionBits ns, and
+// above in buckets of a relative width of at most 2^-(precisionBits-1), so recording is a few shifts and an increment.
+//
+// Benchmarks record one duration per measured operation, then publish the histogram at the end of the run, which adds
+// p50, p90, p99 and max as counters in seconds. With the flag
+//   --latency_histogram_out=<file>   write the full distribution of every published histogram as CSV
+// the bucket counts are written with the name of the run by HistogramReporter.
+class LatencyHistogram
+{
+public:
+    explicit LatencyHistogram(int precisionBits = 7);
+
+    static void parseArguments(int& argc, char** argv);
+
+    void record(int64_t nanoseconds);
+
+    template <typename Rep, typename Period>
+    void record(std::chrono::duration<Rep, Period> duration)
+    {
+        record(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    int64_t count() const;
+    int64_t min() const;
+    int64_t max() const;
+
+    // Highest value of the bucket that holds the given quantile in [0, 1], in nanoseconds
+    int64_t quantile(double quantile) const;
+
+    // Adds the percentiles as counters '<prefix>p50' and so on, and keeps the distribution for the output file. Only
+    // the first thread of a benchmark publishes.
+    void publish(benchmark::State& state, const std::string& prefix = "latency_") const;
+
+    // Writes the histograms published since the last call with the names of the given runs, one per iteration run
+    static void writePublished(const std::vector<benchmark::BenchmarkReporter::Run>& runs);
+
+private:
+    size_t indexOf(int64_t value) const;
+    int64_t highestValueOf(size_t index) const;
+
+    const int precisionBits_;
+    std::vector<int64_t> counts_;
+    int64_t count_{0};
+    int64_t min_{INT64_MAX};
+    int64_t max_{0};
+
+    inline static std::string outputPath_;
+    inline static bool outputStarted_ = false;
+    inline static std::vector<LatencyHistogram> published_;
+};
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Allocator for trivial element types that takes the storage from calloc and leaves elements that are constructed
+// without a value untouched. Large blocks come straight from mmap as zero pages, which the kernel only maps and clears
+// on their first write, so allocating even gigabytes costs nothing up front while every element still reads as zero.
+template <typename T>
+struct ZeroPageAllocator
+{
+    static_assert(std::is_trivially_default_constructible_v<T>, "Elements have to be trivially constructible");
+
+    using value_type = T;
+
+    ZeroPageAllocator() = default;
+
+    template <typename U>
+    ZeroPageAllocator(const ZeroPageAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        void* pointer = std::calloc(count, sizeof(T));
+        if (pointer == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(pointer);
+    }
+
+    void deallocate(T* pointer, size_t)
+    {
+        std::free(pointer);
+    }
+
+    template <typename U>
+    void construct(U* pointer)
+    {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* pointer, Args&&... args)
+    {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    template <typename U>
+    bool operator==(const ZeroPageAllocator<U>&) const
+    {
+        return true;
+    }
+};
+
+// Row major matrix, elements of a row are adjacent, with bounds checked element access and raw access to the storage
+// for kernels.
+//
+// The constructor only reserves zero pages, and reading elements that were never written reads the one shared zero
+// page of the kernel instead of memory. Matrices that kernels read from should come from filled or random, which
+// write every element from all cpus, each cpu a band of rows, so that the pages of a band are placed at the cpu that
+// touched them first.
+template <typename T>
+class Matrix2D : private std::vector<T, ZeroPageAllocator<T>>
+{
+    using Storage = std::vector<T, ZeroPageAllocator<T>>;
+
+public:
+    Matrix2D(size_t width, size_t height)
+        : Storage(width * height)
+        , width_(width)
+        , height_(height)
+    {
+    }
+
+    static Matrix2D filled(size_t width, size_t height, T value)
+    {
+        auto matrix = Matrix2D(width, height);
+        matrix.forRowBands([&](size_t firstRow, size_t lastRow) {
+            std::fill(matrix.data() + firstRow * width, matrix.data() + lastRow * width, value);
+        });
+        return matrix;
+    }
+
+    // Uniformly distributed values in [min, max), the same for a seed independent of the number of cpus
+    static Matrix2D random(size_t width, size_t height, uint64_t seed, T min = T{0}, T max = T{1})
+    {
+        using Distribution = std::conditional_t<std::is_floating_point_v<T>, std::uniform_real_distribution<T>,
+                                                std::uniform_int_distribution<T>>;
+
+        auto matrix = Matrix2D(width, height);
+        matrix.forRowBands([&](size_t firstRow, size_t lastRow) {
+            auto distribution = Distribution(min, std::is_floating_point_v<T> ? max : static_cast<T>(max - 1));
+            for (size_t y = firstRow; y < lastRow; y++)
+            {
+                auto seedSequence = std::seed_seq{seed, static_cast<uint64_t>(y)};
+                auto random = std::mt19937_64(seedSequence);
+                std::generate(matrix.data() + y * width, matrix.data() + (y + 1) * width,
+                              [&] { return distribution(random); });
+            }
+        });
+        return matrix;
+    }
+
+    T getElem(size_t x, size_t y) const
+    {
+        return Storage::at(x + y * width_);
+    }
+
+    void setElem(size_t x, size_t y, T value)
+    {
+        Storage::at(x + y * width_) = value;
+    }
+
+    size_t width() const
+    {
+        return width_;
+    }
+
+    size_t height() const
+    {
+        return height_;
+    }
+
+    const T* data() const
+    {
+        return Storage::data();
+    }
+
+    T* data()
+    {
+        return Storage::data();
+    }
+
+private:
+    // Calls fillRows(firstRow, lastRow) for a band of rows per cpu, each on a thread of its own
+    template <typename FillRows>
+    void forRowBands(FillRows fillRows)
+    {
+        const size_t numOfBands =
+            std::clamp<size_t>(std::thread::hardware_concurrency(), 1, std::max<size_t>(height_, 1));
+        auto threads = std::vector<std::thread>();
+        for (size_t band = 1; band < numOfBands; band++)
+        {
+            threads.emplace_back(fillRows, height_ * band / numOfBands, height_ * (band + 1) / numOfBands);
+        }
+        fillRows(0, height_ / numOfBands);
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    const size_t width_;
+    const size_t height_;
+};
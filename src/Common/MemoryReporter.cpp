@@ -0,0 +1,67 @@
+#include "Common/MemoryReporter.h"
+
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+// Google Benchmark 1.8 stores the memory result by value instead of by pointer
+template <typename RunType>
+const benchmark::MemoryManager::Result* memoryResultOf(const RunType& run)
+{
+    if constexpr (std::is_pointer_v<decltype(run.memory_result)>)
+    {
+        return run.memory_result;
+    }
+    else
+    {
+        const auto& result = run.memory_result;
+        return result.num_allocs > 0 || result.max_bytes_used > 0 ? &result : nullptr;
+    }
+}
+} // namespace
+
+MemoryReporter::MemoryReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter)
+    : displayReporter_(std::move(displayReporter))
+{
+}
+
+bool MemoryReporter::ReportContext(const Context& context)
+{
+    return displayReporter_->ReportContext(context);
+}
+
+void MemoryReporter::ReportRuns(const std::vector<Run>& reports)
+{
+    auto runs = reports;
+    for (auto& run : runs)
+    {
+        const auto* result = memoryResultOf(run);
+        if (run.run_type != Run::RT_Iteration || !result)
+        {
+            continue;
+        }
+
+        run.counters["allocs"] = benchmark::Counter(run.allocs_per_iter);
+        run.counters["peak_heap"] =
+            benchmark::Counter(static_cast<double>(result->max_bytes_used), benchmark::Counter::kDefaults,
+                               benchmark::Counter::kIs1024);
+
+        // Google Benchmark only reports the allocations per iteration, the iterations of the memory run follow. Missing
+        // values hold MemoryManager::TombstoneValue, which is not exported by every build of the library.
+        if (result->total_allocated_bytes != std::numeric_limits<int64_t>::max() && run.allocs_per_iter > 0)
+        {
+            const auto memoryIterations = static_cast<double>(result->num_allocs) / run.allocs_per_iter;
+            run.counters["bytes_allocated"] =
+                benchmark::Counter(static_cast<double>(result->total_allocated_bytes) / memoryIterations,
+                                   benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+        }
+    }
+
+    displayReporter_->ReportRuns(runs);
+}
+
+void MemoryReporter::Finalize()
+{
+    displayReporter_->Finalize();
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+// Forwards everything to the display reporter, with the allocations that MemoryTracker counted for a run added as
+// counters: allocations and bytes allocated per iteration, and the peak of live heap bytes. The JSON file reporter
+// already writes them on its own.
+class MemoryReporter : public benchmark::BenchmarkReporter
+{
+public:
+    explicit MemoryReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter);
+
+    bool ReportContext(const Context& context) override;
+    void ReportRuns(const std::vector<Run>& reports) override;
+    void Finalize() override;
+
+private:
+    std::unique_ptr<benchmark::BenchmarkReporter> displayReporter_;
+};
@@ -0,0 +1,334 @@
+#include "Common/MemoryTracker.h"
+
+#include "Common/CommandLine.h"
+
+#include <malloc.h>
+#include <sys/resource.h>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+// Allocations count between Start and Stop of the memory run, and there only while the fixture runs, from the first
+// profiling region on if the benchmark has one, or else from beginRun on, until endRun
+std::atomic<bool> tracking{false};
+std::atomic<bool> inRun{false};
+std::atomic<bool> regionStarted{false};
+std::atomic<int64_t> numAllocs{0};
+std::atomic<int64_t> allocatedBytes{0};
+std::atomic<int64_t> liveBytes{0};
+std::atomic<int64_t> peakLiveBytes{0};
+
+#ifdef __GLIBC__
+// Addresses of the blocks counted since the last reset, so that only their frees reduce the live bytes. Open
+// addressing with linear probing, freed blocks leave a tombstone until the next reset. A block that finds no free slot
+// within maxProbes still counts, but its free does not, which overstates the live bytes.
+constexpr size_t numOfSlotsLog2 = 18;
+constexpr size_t numOfSlots = size_t{1} << numOfSlotsLog2;
+constexpr size_t maxProbes = 64;
+constexpr uintptr_t tombstone = 1;
+std::array<std::atomic<uintptr_t>, numOfSlots> countedBlocks;
+
+size_t slotOf(uintptr_t address)
+{
+    return static_cast<size_t>((address >> 4) * 0x9E3779B97F4A7C15ull >> (64 - numOfSlotsLog2));
+}
+
+void rememberBlock(uintptr_t address)
+{
+    for (size_t probe = 0, slot = slotOf(address); probe < maxProbes; probe++, slot = (slot + 1) % numOfSlots)
+    {
+        auto expected = countedBlocks[slot].load(std::memory_order_relaxed);
+        if ((expected == 0 || expected == tombstone) &&
+            countedBlocks[slot].compare_exchange_strong(expected, address, std::memory_order_relaxed))
+        {
+            return;
+        }
+    }
+}
+
+bool forgetBlock(uintptr_t address)
+{
+    for (size_t probe = 0, slot = slotOf(address); probe < maxProbes; probe++, slot = (slot + 1) % numOfSlots)
+    {
+        const auto value = countedBlocks[slot].load(std::memory_order_relaxed);
+        if (value == address)
+        {
+            countedBlocks[slot].store(tombstone, std::memory_order_relaxed);
+            return true;
+        }
+        if (value == 0)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+bool counting()
+{
+    return tracking.load(std::memory_order_relaxed) && inRun.load(std::memory_order_relaxed);
+}
+
+void recordAllocation(void* pointer)
+{
+    if (!pointer || !counting())
+    {
+        return;
+    }
+
+    const auto size = static_cast<int64_t>(malloc_usable_size(pointer));
+    numAllocs.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const auto live = liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    rememberBlock(reinterpret_cast<uintptr_t>(pointer));
+
+    auto peak = peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void recordDeallocation(void* pointer)
+{
+    if (!pointer || !counting() || !forgetBlock(reinterpret_cast<uintptr_t>(pointer)))
+    {
+        return;
+    }
+
+    liveBytes.fetch_sub(static_cast<int64_t>(malloc_usable_size(pointer)), std::memory_order_relaxed);
+}
+#endif
+
+void resetCounts()
+{
+    numAllocs = 0;
+    allocatedBytes = 0;
+    liveBytes = 0;
+    peakLiveBytes = 0;
+#ifdef __GLIBC__
+    for (auto& block : countedBlocks)
+    {
+        block.store(0, std::memory_order_relaxed);
+    }
+#endif
+}
+} // namespace
+
+#ifdef __GLIBC__
+// The malloc family of the executable takes precedence over the one of the C library for every shared library too,
+// including the operator new of libstdc++ and the OpenMP runtime. The original implementations stay reachable under
+// their __libc_ names.
+extern "C"
+{
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t count, size_t size);
+    void* __libc_realloc(void* pointer, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void* __libc_valloc(size_t size);
+    void* __libc_pvalloc(size_t size);
+    void __libc_free(void* pointer);
+
+    void* malloc(size_t size) noexcept
+    {
+        auto* pointer = __libc_malloc(size);
+        recordAllocation(pointer);
+        return pointer;
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        auto* pointer = __libc_calloc(count, size);
+        recordAllocation(pointer);
+        return pointer;
+    }
+
+    void* realloc(void* pointer, size_t size) noexcept
+    {
+        recordDeallocation(pointer);
+        auto* newPointer = __libc_realloc(pointer, size);
+        recordAllocation(newPointer);
+        return newPointer;
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        auto* pointer = __libc_memalign(alignment, size);
+        recordAllocation(pointer);
+        return pointer;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        return memalign(alignment, size);
+    }
+
+    int posix_memalign(void** pointer, size_t alignment, size_t size) noexcept
+    {
+        if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        {
+            return EINVAL;
+        }
+        *pointer = memalign(alignment, size);
+        return *pointer || size == 0 ? 0 : ENOMEM;
+    }
+
+    void* valloc(size_t size) noexcept
+    {
+        auto* pointer = __libc_valloc(size);
+        recordAllocation(pointer);
+        return pointer;
+    }
+
+    void* pvalloc(size_t size) noexcept
+    {
+        auto* pointer = __libc_pvalloc(size);
+        recordAllocation(pointer);
+        return pointer;
+    }
+
+    void free(void* pointer) noexcept
+    {
+        recordDeallocation(pointer);
+        __libc_free(pointer);
+    }
+}
+#endif
+
+void MemoryTracker::parseArguments(int& argc, char** argv)
+{
+    if (const auto tracking = CommandLine::extractFlag(argc, argv, "memory_tracking"))
+    {
+        if (*tracking == "true")
+        {
+            enabled_ = true;
+        }
+        else if (*tracking == "false")
+        {
+            enabled_ = false;
+        }
+        else
+        {
+            throw std::runtime_error("Unknown memory tracking setting '" + *tracking + "', expected true or false!");
+        }
+    }
+}
+
+void MemoryTracker::install()
+{
+    static auto tracker = MemoryTracker();
+    if (enabled_)
+    {
+        benchmark::RegisterMemoryManager(&tracker);
+    }
+}
+
+bool MemoryTracker::measuring()
+{
+    return tracking.load(std::memory_order_relaxed);
+}
+
+void MemoryTracker::beginRun(benchmark::State& state)
+{
+    if (state.thread_index() != 0)
+    {
+        return;
+    }
+
+    // The measurement itself allocates, which must not count towards the benchmark
+    resetPeakResidentBytes();
+    pageFaultsAtBegin_ = pageFaults();
+    regionStarted = false;
+    inRun = true;
+}
+
+void MemoryTracker::beginRegion()
+{
+    if (!regionStarted.exchange(true) && tracking)
+    {
+        resetCounts();
+    }
+}
+
+void MemoryTracker::endRun(benchmark::State& state)
+{
+    if (state.thread_index() != 0)
+    {
+        return;
+    }
+
+    inRun = false;
+    state.counters["page_faults"] = benchmark::Counter(static_cast<double>(pageFaults() - pageFaultsAtBegin_),
+                                                       benchmark::Counter::kAvgIterations);
+    state.counters["peak_rss"] = benchmark::Counter(static_cast<double>(peakResidentBytes()),
+                                                    benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+MemoryTracker::Pause::Pause()
+    : wasInRun_(inRun.exchange(false))
+{
+}
+
+MemoryTracker::Pause::~Pause()
+{
+    inRun = wasInRun_;
+}
+
+void MemoryTracker::Start()
+{
+    resetCounts();
+    tracking = true;
+}
+
+void MemoryTracker::Stop(Result& result)
+{
+    tracking = false;
+
+#ifdef __GLIBC__
+    result.num_allocs = numAllocs;
+    result.max_bytes_used = peakLiveBytes;
+    result.total_allocated_bytes = allocatedBytes;
+    result.net_heap_growth = liveBytes;
+#else
+    result.num_allocs = 0;
+    result.max_bytes_used = 0;
+#endif
+}
+
+int64_t MemoryTracker::pageFaults()
+{
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+// The high water mark of the process after the last reset, getrusage only knows the maximum since process start
+int64_t MemoryTracker::peakResidentBytes()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.starts_with("VmHWM:"))
+        {
+            return std::stoll(line.substr(6)) * 1024;
+        }
+    }
+
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+}
+
+void MemoryTracker::resetPeakResidentBytes()
+{
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+// Counts heap allocations through an interposer of the malloc family, which also sees every operator new, and hands
+// them to Google Benchmark as its MemoryManager. Google Benchmark then runs every benchmark once more with a few
+// iterations between Start and Stop, and MemoryReporter shows the results as counters.
+//
+// Independent of that, fixtures call beginRun and endRun from SetUp and TearDown to report the page faults per
+// iteration and the peak resident set size of the timed run. Only allocations between these two calls count, on any
+// thread, and only from the start of the first ProfilingRegion on if the benchmark has one, so neither Google
+// Benchmark itself nor the setup of the benchmark shows up in the counts. Frees only count for blocks that were
+// counted. Controlled by the flag
+//   --memory_tracking=true|false   whether to do the additional run that counts allocations (default false)
+class MemoryTracker : public benchmark::MemoryManager
+{
+public:
+    static void parseArguments(int& argc, char** argv);
+
+    // Registers the tracker with Google Benchmark, unless disabled on the command line
+    static void install();
+
+    // Whether the additional run that counts allocations is in progress
+    static bool measuring();
+
+    static void beginRun(benchmark::State& state);
+    static void endRun(benchmark::State& state);
+
+    // Discards what was counted since beginRun when the first profiling region of the run starts
+    static void beginRegion();
+
+    // Stops counting allocations while it lives, for the counters that benchmarks publish after the timed loop
+    class Pause
+    {
+    public:
+        Pause();
+        ~Pause();
+
+        Pause(const Pause&) = delete;
+        Pause& operator=(const Pause&) = delete;
+
+    private:
+        bool wasInRun_;
+    };
+
+    void Start() override;
+    void Stop(Result& result) override;
+
+    // Google Benchmark before 1.8 only calls the pointer overload
+    void Stop(Result* result)
+    {
+        Stop(*result);
+    }
+
+private:
+    static int64_t pageFaults();
+    static int64_t peakResidentBytes();
+    static void resetPeakResidentBytes();
+
+    inline static bool enabled_ = false;
+    inline static int64_t pageFaultsAtBegin_ = 0;
+};
@@ -0,0 +1,44 @@
+# Build variants on top of Release for the suites (the benchmark library itself is not affected):
+#
+#   BENCHMARK_SUITE_LTO=ON              link time optimization
+#   BENCHMARK_SUITE_PGO=GENERATE|USE    two-stage profile guided optimization, the profiles are kept in
+#                                       BENCHMARK_SUITE_PGO_DIRECTORY. Train by building 'representative_benchmarks'
+#                                       in the GENERATE configuration, then reconfigure the same build folder with USE.
+#   BENCHMARK_SUITE_BOLT=ON             keep relocations in the executables for BOLT post-link optimization, see the
+#                                       bolt_benchmarks target
+#
+# build_optimized.sh builds all variants and compares them against plain Release.
+
+option(BENCHMARK_SUITE_LTO "Build the suites with link time optimization" OFF)
+set(BENCHMARK_SUITE_PGO "" CACHE STRING "Profile guided optimization stage: GENERATE, USE or empty")
+set_property(CACHE BENCHMARK_SUITE_PGO PROPERTY STRINGS "" GENERATE USE)
+set(BENCHMARK_SUITE_PGO_DIRECTORY ${CMAKE_BINARY_DIR}/pgo-profiles CACHE PATH "Folder of the PGO profiles")
+option(BENCHMARK_SUITE_BOLT "Link the suites with relocations for BOLT" OFF)
+
+if(BENCHMARK_SUITE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT ipoSupported OUTPUT ipoOutput LANGUAGES CXX)
+    if(NOT ipoSupported)
+        message(FATAL_ERROR "Link time optimization is not supported: ${ipoOutput}")
+    endif()
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+endif()
+
+if(BENCHMARK_SUITE_PGO STREQUAL "GENERATE")
+    # The OpenMP suites update the counters from several threads
+    add_compile_options(-fprofile-generate=${BENCHMARK_SUITE_PGO_DIRECTORY} -fprofile-update=atomic)
+    add_link_options(-fprofile-generate=${BENCHMARK_SUITE_PGO_DIRECTORY})
+elseif(BENCHMARK_SUITE_PGO STREQUAL "USE")
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        # Clang needs the raw profiles merged with 'llvm-profdata merge -o default.profdata *.profraw' first
+        add_compile_options(-fprofile-use=${BENCHMARK_SUITE_PGO_DIRECTORY}/default.profdata -Wno-profile-instr-unprofiled)
+    else()
+        add_compile_options(-fprofile-use=${BENCHMARK_SUITE_PGO_DIRECTORY} -fprofile-correction -Wno-missing-profile)
+    endif()
+elseif(NOT BENCHMARK_SUITE_PGO STREQUAL "")
+    message(FATAL_ERROR "Unknown PGO stage '${BENCHMARK_SUITE_PGO}', expected GENERATE, USE or empty")
+endif()
+
+if(BENCHMARK_SUITE_BOLT)
+    add_link_options(-Wl,--emit-relocs)
+endif()
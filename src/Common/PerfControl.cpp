@@ -0,0 +1,66 @@
+#include "Common/PerfControl.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+struct Fifos
+{
+    int control = -1;
+    int acknowledge = -1;
+};
+
+const Fifos& fifos()
+{
+    static const Fifos fifos = [] {
+        Fifos result;
+        const char* controlPath = std::getenv("PERF_CTL_FIFO");
+        const char* acknowledgePath = std::getenv("PERF_ACK_FIFO");
+        if (controlPath && acknowledgePath)
+        {
+            result.control = open(controlPath, O_WRONLY | O_CLOEXEC);
+            result.acknowledge = open(acknowledgePath, O_RDONLY | O_CLOEXEC);
+            if (result.control < 0 || result.acknowledge < 0)
+            {
+                throw std::runtime_error(std::string("Could not open the perf control fifos '") + controlPath + "' and '" +
+                                         acknowledgePath + "'!");
+            }
+        }
+        return result;
+    }();
+    return fifos;
+}
+} // namespace
+
+void PerfControl::enable()
+{
+    send("enable\n");
+}
+
+void PerfControl::disable()
+{
+    send("disable\n");
+}
+
+void PerfControl::send(const char* command)
+{
+    const auto& [control, acknowledge] = fifos();
+    if (control < 0)
+    {
+        return;
+    }
+
+    // perf answers every command with "ack\n" once it has been applied. Failures are ignored, this also runs from the
+    // destructor of ProfilingRegion and a perf session that went away only means that no more samples are taken.
+    char reply[5] = {};
+    if (write(control, command, std::strlen(command)) > 0)
+    {
+        [[maybe_unused]] const auto bytesRead = read(acknowledge, reply, sizeof(reply) - 1);
+    }
+}
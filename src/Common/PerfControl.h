@@ -0,0 +1,14 @@
+#pragma once
+
+// Enables and disables a 'perf record --control=fifo:<ctl>,<ack> --delay=-1' session around the measured region, so
+// that samples are only taken inside the timed loop. The fifos are taken from the PERF_CTL_FIFO and PERF_ACK_FIFO
+// environment variables, set by tools/perf_flamegraph.sh. Without them, both calls do nothing.
+class PerfControl
+{
+public:
+    static void enable();
+    static void disable();
+
+private:
+    static void send(const char* command);
+};
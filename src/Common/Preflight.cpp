@@ -0,0 +1,177 @@
+#include "Common/Preflight.h"
+
+#include "Common/CommandLine.h"
+#include "Common/CpuTopology.h"
+#include "Common/IsaLevel.h"
+
+#include <benchmark/benchmark.h>
+#include <sched.h>
+#include <sys/utsname.h>
+
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+namespace
+{
+std::string readLine(const std::string& path)
+{
+    std::ifstream file(path);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+} // namespace
+
+void Preflight::parseArguments(int& argc, char** argv)
+{
+    if (const auto policy = CommandLine::extractFlag(argc, argv, "preflight_governor"))
+    {
+        if (*policy == "ignore")
+        {
+            governorPolicy_ = GovernorPolicy::Ignore;
+        }
+        else if (*policy == "warn")
+        {
+            governorPolicy_ = GovernorPolicy::Warn;
+        }
+        else if (*policy == "refuse")
+        {
+            governorPolicy_ = GovernorPolicy::Refuse;
+        }
+        else
+        {
+            throw std::runtime_error("Unknown governor policy '" + *policy + "', expected ignore, warn or refuse!");
+        }
+    }
+
+    if (const auto cpus = CommandLine::extractFlag(argc, argv, "preflight_pin"))
+    {
+        pinCpus_ = *cpus;
+    }
+}
+
+bool Preflight::run()
+{
+    const auto& topology = CpuTopology::get();
+    const auto currentGovernor = governor();
+
+    benchmark::AddCustomContext("cpu_model", cpuModel());
+    benchmark::AddCustomContext("cpu_governor", currentGovernor);
+    benchmark::AddCustomContext("cpu_turbo", turboState());
+    benchmark::AddCustomContext("smt_topology", topology.describeSmt());
+    benchmark::AddCustomContext("numa_layout", topology.describeNuma());
+    benchmark::AddCustomContext("cache_sizes", topology.describeCaches());
+    benchmark::AddCustomContext("kernel", kernelVersion());
+    benchmark::AddCustomContext("isa_level", IsaSupport::name(IsaSupport::best()));
+
+    if (governorPolicy_ != GovernorPolicy::Ignore && currentGovernor != "performance")
+    {
+        std::cerr << "***WARNING*** CPU frequency governor is '" << currentGovernor
+                  << "' instead of 'performance', timings will be noisy.\n";
+        if (governorPolicy_ == GovernorPolicy::Refuse && currentGovernor != "unknown")
+        {
+            std::cerr << "Refusing to run benchmarks, pass --preflight_governor=warn to run anyway.\n";
+            return false;
+        }
+    }
+
+    if (!pinCpus_.empty() && !pinToCpus(pinCpus_))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+std::string Preflight::cpuModel()
+{
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+    {
+        if (line.starts_with("model name"))
+        {
+            return line.substr(line.find(':') + 2);
+        }
+    }
+    return "unknown";
+}
+
+std::string Preflight::governor()
+{
+    // Report a single governor if all cpus agree, the distinct ones otherwise
+    auto governors = std::set<std::string>();
+    for (const auto& cpu : CpuTopology::get().cpus())
+    {
+        const auto cpuGovernor =
+            readLine("/sys/devices/system/cpu/cpu" + std::to_string(cpu.id) + "/cpufreq/scaling_governor");
+        if (!cpuGovernor.empty())
+        {
+            governors.insert(cpuGovernor);
+        }
+    }
+
+    if (governors.empty())
+    {
+        return "unknown";
+    }
+
+    std::string result;
+    for (const auto& cpuGovernor : governors)
+    {
+        result += (result.empty() ? "" : ",") + cpuGovernor;
+    }
+    return result;
+}
+
+std::string Preflight::turboState()
+{
+    if (const auto noTurbo = readLine("/sys/devices/system/cpu/intel_pstate/no_turbo"); !noTurbo.empty())
+    {
+        return noTurbo == "1" ? "disabled" : "enabled";
+    }
+    if (const auto boost = readLine("/sys/devices/system/cpu/cpufreq/boost"); !boost.empty())
+    {
+        return boost == "1" ? "enabled" : "disabled";
+    }
+    return "unknown";
+}
+
+std::string Preflight::kernelVersion()
+{
+    utsname name{};
+    if (uname(&name) != 0)
+    {
+        return "unknown";
+    }
+    return std::string(name.sysname) + " " + name.release + " " + name.machine;
+}
+
+bool Preflight::pinToCpus(const std::string& cpuList)
+{
+    const auto cpus = cpuList == "isolated" ? CpuTopology::get().isolatedCpus() : CpuTopology::parseCpuList(cpuList);
+    if (cpus.empty())
+    {
+        std::cerr << "***WARNING*** No cpus to pin to for '" << cpuList << "', running unpinned.\n";
+        return true;
+    }
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (const int cpu : cpus)
+    {
+        CPU_SET(cpu, &cpuSet);
+    }
+
+    // Threads spawned later, including the OpenMP team, inherit the affinity of the main thread
+    if (sched_setaffinity(0, sizeof(cpuSet), &cpuSet) != 0)
+    {
+        std::cerr << "Could not pin the benchmark process to cpus " << CpuTopology::formatCpuList(cpus) << "!\n";
+        return false;
+    }
+
+    benchmark::AddCustomContext("pinned_cpus", CpuTopology::formatCpuList(cpus));
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+
+// Records the machine configuration into the benchmark context and checks it for known sources of noise before any
+// benchmark runs. Controlled by the flags
+//   --preflight_governor=ignore|warn|refuse   what to do when the cpu frequency governor is not 'performance'
+//   --preflight_pin=isolated|<cpu list>       pin the process (and the threads it spawns) to the given cpus
+class Preflight
+{
+public:
+    enum class GovernorPolicy
+    {
+        Ignore,
+        Warn,
+        Refuse,
+    };
+
+    static void parseArguments(int& argc, char** argv);
+
+    // Returns false if the benchmarks should not be run
+    static bool run();
+
+private:
+    static std::string cpuModel();
+    static std::string governor();
+    static std::string turboState();
+    static std::string kernelVersion();
+    static bool pinToCpus(const std::string& cpuList);
+
+    inline static GovernorPolicy governorPolicy_ = GovernorPolicy::Warn;
+    inline static std::string pinCpus_;
+};
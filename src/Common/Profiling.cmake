@@ -0,0 +1,154 @@
+# Profiling targets for single benchmarks of a suite:
+#
+#   add_profiling_targets(<suite target>
+#       [ITERATIONS <n>]
+#       BENCHMARKS <benchmark name>...
+#   )
+#
+# For every benchmark, e.g. 'MatrixOperations/LoopTiling/cache:0/scale:0/aspect:0', this creates
+#   profile_<suite>_<benchmark>     callgrind profile of the timed loop only
+#   cachegrind_<suite>_<benchmark>  cachegrind cache simulation, annotated per source line
+#   perf_<suite>_<benchmark>        perf sampling of the timed loop, folded stacks and an SVG flame graph
+# Each target runs only the given benchmark for a fixed number of iterations, and instrumentation is switched on by
+# the ProfilingRegion around the state loop. Outputs go to <build>/profile. Build RelWithDebInfo for line information.
+# The perf targets use DWARF call graphs unless BENCHMARK_SUITE_FRAME_POINTERS is on.
+#
+# The benchmarks also form the representative set of the suite:
+#   representative_benchmarks       runs the set of every suite with repetitions into <build>/results/<suite>.json,
+#                                   used as PGO training run and to compare build variants
+#   bolt_benchmarks                 with BENCHMARK_SUITE_BOLT, optimizes every suite with llvm-bolt trained on the set
+#                                   into <build>/bolt and runs the set again into <build>/results/bolt/<suite>.json
+
+find_program(VALGRIND_EXECUTABLE valgrind)
+find_program(CG_ANNOTATE_EXECUTABLE cg_annotate)
+find_program(PERF_EXECUTABLE perf)
+find_program(LLVM_BOLT_EXECUTABLE llvm-bolt)
+
+if(VALGRIND_EXECUTABLE)
+    execute_process(COMMAND ${VALGRIND_EXECUTABLE} --version OUTPUT_VARIABLE VALGRIND_VERSION OUTPUT_STRIP_TRAILING_WHITESPACE)
+    string(REGEX REPLACE "^valgrind-" "" VALGRIND_VERSION "${VALGRIND_VERSION}")
+endif()
+
+set(PROFILING_OUTPUT_DIRECTORY ${CMAKE_BINARY_DIR}/profile)
+set(PERF_FLAMEGRAPH_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/../../tools/perf_flamegraph.sh)
+set(BENCHMARK_SUITE_REPRESENTATIVE_REPETITIONS 5 CACHE STRING "Repetitions of the representative benchmark runs")
+
+add_custom_target(representative_benchmarks)
+if(BENCHMARK_SUITE_BOLT)
+    if(NOT LLVM_BOLT_EXECUTABLE)
+        message(FATAL_ERROR "BENCHMARK_SUITE_BOLT needs llvm-bolt")
+    endif()
+    add_custom_target(bolt_benchmarks)
+endif()
+
+function(add_profiling_targets target)
+    cmake_parse_arguments(PROFILING "" "ITERATIONS" "BENCHMARKS" ${ARGN})
+    if(NOT PROFILING_ITERATIONS)
+        set(PROFILING_ITERATIONS 1)
+    endif()
+
+    if(BENCHMARK_SUITE_FRAME_POINTERS)
+        set(callGraph fp)
+    else()
+        set(callGraph dwarf)
+    endif()
+
+    # Cachegrind can only start with instrumentation disabled since valgrind 3.22
+    set(cachegrindOptions --cache-sim=yes)
+    if(VALGRIND_VERSION VERSION_GREATER_EQUAL 3.22)
+        list(APPEND cachegrindOptions --instr-at-start=no)
+    endif()
+
+    # Iteration counts for --benchmark_min_time are only understood since Google Benchmark 1.8, older versions stop
+    # after a single iteration with a minimum time of 0
+    if(BENCHMARK_SUITE_BENCHMARK_VERSION VERSION_LESS 1.8)
+        set(minTime 0)
+    else()
+        set(minTime ${PROFILING_ITERATIONS}x)
+    endif()
+
+    list(JOIN PROFILING_BENCHMARKS "|" representativeBenchmarks)
+    set(representativeArguments "--benchmark_filter=^(${representativeBenchmarks})$"
+        --benchmark_repetitions=${BENCHMARK_SUITE_REPRESENTATIVE_REPETITIONS} --benchmark_out_format=json)
+    set(resultDirectory ${CMAKE_BINARY_DIR}/results)
+
+    add_custom_target(representative_${target}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${resultDirectory}
+        COMMAND $<TARGET_FILE:${target}> ${representativeArguments} --benchmark_out=${resultDirectory}/${target}.json
+        DEPENDS ${target}
+        COMMENT "Running the representative benchmarks of ${target}"
+        USES_TERMINAL
+        VERBATIM
+    )
+    add_dependencies(representative_benchmarks representative_${target})
+
+    if(BENCHMARK_SUITE_BOLT)
+        set(boltDirectory ${CMAKE_BINARY_DIR}/bolt)
+        add_custom_target(bolt_${target}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${boltDirectory} ${resultDirectory}/bolt
+            COMMAND ${LLVM_BOLT_EXECUTABLE} $<TARGET_FILE:${target}> -instrument
+                --instrumentation-file=${boltDirectory}/${target}.fdata -o ${boltDirectory}/${target}.instrumented
+            COMMAND ${boltDirectory}/${target}.instrumented "--benchmark_filter=^(${representativeBenchmarks})$"
+            COMMAND ${LLVM_BOLT_EXECUTABLE} $<TARGET_FILE:${target}> -o ${boltDirectory}/${target}
+                -data=${boltDirectory}/${target}.fdata -reorder-blocks=ext-tsp -reorder-functions=hfsort
+                -split-functions -split-all-cold -dyno-stats
+            COMMAND ${boltDirectory}/${target} ${representativeArguments}
+                --benchmark_out=${resultDirectory}/bolt/${target}.json
+            DEPENDS ${target}
+            COMMENT "Optimizing ${target} with BOLT"
+            USES_TERMINAL
+            VERBATIM
+        )
+        add_dependencies(bolt_benchmarks bolt_${target})
+    endif()
+
+    foreach(benchmark ${PROFILING_BENCHMARKS})
+        string(REGEX REPLACE "[/:]" "_" suffix "${target}_${benchmark}")
+        set(benchmarkArguments "--benchmark_filter=^${benchmark}$" --benchmark_min_time=${minTime})
+
+        if(PERF_EXECUTABLE)
+            add_custom_target(perf_${suffix}
+                COMMAND ${PERF_FLAMEGRAPH_SCRIPT} ${PROFILING_OUTPUT_DIRECTORY}/perf.${suffix} ${callGraph}
+                    $<TARGET_FILE:${target}> ${benchmarkArguments}
+                DEPENDS ${target}
+                COMMENT "Sampling ${benchmark} of ${target} with perf"
+                USES_TERMINAL
+                VERBATIM
+            )
+        endif()
+
+        if(NOT VALGRIND_EXECUTABLE)
+            continue()
+        endif()
+
+        add_custom_target(profile_${suffix}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${PROFILING_OUTPUT_DIRECTORY}
+            COMMAND ${VALGRIND_EXECUTABLE} --tool=callgrind --instr-atstart=no
+                --callgrind-out-file=${PROFILING_OUTPUT_DIRECTORY}/callgrind.out.${suffix}
+                $<TARGET_FILE:${target}> ${benchmarkArguments}
+            DEPENDS ${target}
+            COMMENT "Profiling ${benchmark} of ${target} with callgrind"
+            USES_TERMINAL
+            VERBATIM
+        )
+
+        set(annotateCommand)
+        if(CG_ANNOTATE_EXECUTABLE)
+            set(annotateCommand COMMAND ${CG_ANNOTATE_EXECUTABLE} --auto=yes
+                --show=Dr,D1mr,DLmr,Dw,D1mw,DLmw ${PROFILING_OUTPUT_DIRECTORY}/cachegrind.out.${suffix}
+                > ${PROFILING_OUTPUT_DIRECTORY}/cachegrind.${suffix}.txt)
+        endif()
+
+        add_custom_target(cachegrind_${suffix}
+            COMMAND ${CMAKE_COMMAND} -E make_directory ${PROFILING_OUTPUT_DIRECTORY}
+            COMMAND ${VALGRIND_EXECUTABLE} --tool=cachegrind ${cachegrindOptions}
+                --cachegrind-out-file=${PROFILING_OUTPUT_DIRECTORY}/cachegrind.out.${suffix}
+                $<TARGET_FILE:${target}> ${benchmarkArguments}
+            ${annotateCommand}
+            DEPENDS ${target}
+            COMMENT "Simulating the caches for ${benchmark} of ${target} with cachegrind"
+            USES_TERMINAL
+            VERBATIM
+        )
+    endforeach()
+endfunction()
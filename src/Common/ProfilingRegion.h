@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Common/MemoryTracker.h"
+#include "Common/PerfControl.h"
+
+#if __has_include(<valgrind/callgrind.h>)
+#include <valgrind/callgrind.h>
+#else
+#define CALLGRIND_START_INSTRUMENTATION
+#define CALLGRIND_STOP_INSTRUMENTATION
+#endif
+
+#if __has_include(<valgrind/cachegrind.h>)
+#include <valgrind/cachegrind.h>
+#else
+#define CACHEGRIND_START_INSTRUMENTATION
+#define CACHEGRIND_STOP_INSTRUMENTATION
+#endif
+
+// Limits callgrind and cachegrind instrumentation and perf sampling to the timed loop of a benchmark, when the tools are
+// started with instrumentation disabled (see the profile_*, cachegrind_* and perf_* targets). Declare it right before
+// the state loop:
+//
+//     const auto profilingRegion = ProfilingRegion();
+//     for (auto _ : state)
+//
+// Outside of valgrind and perf, this costs a few instructions once per benchmark run. The allocations that
+// MemoryTracker counts also start here.
+class ProfilingRegion
+{
+public:
+    ProfilingRegion()
+    {
+        MemoryTracker::beginRegion();
+        CALLGRIND_START_INSTRUMENTATION;
+        CACHEGRIND_START_INSTRUMENTATION;
+        PerfControl::enable();
+    }
+
+    ~ProfilingRegion()
+    {
+        PerfControl::disable();
+        CACHEGRIND_STOP_INSTRUMENTATION;
+        CALLGRIND_STOP_INSTRUMENTATION;
+    }
+
+    ProfilingRegion(const ProfilingRegion&) = delete;
+    ProfilingRegion& operator=(const ProfilingRegion&) = delete;
+};
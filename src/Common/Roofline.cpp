@@ -0,0 +1,244 @@
+#include "Common/Roofline.h"
+
+#include "Common/CommandLine.h"
+#include "Common/CpuTopology.h"
+#include "Common/MemoryTracker.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+void Roofline::parseArguments(int& argc, char** argv)
+{
+    if (const auto path = CommandLine::extractFlag(argc, argv, "roofline"))
+    {
+        path_ = *path;
+        load();
+    }
+}
+
+const std::vector<std::string>& Roofline::memoryLevels()
+{
+    static const auto levels = [] {
+        auto levels = std::vector<std::string>();
+        for (const auto& cache : CpuTopology::get().caches())
+        {
+            const auto name = "l" + std::to_string(cache.level);
+            if (cache.type != "Instruction" && std::find(levels.begin(), levels.end(), name) == levels.end())
+            {
+                levels.push_back(name);
+            }
+        }
+        std::sort(levels.begin(), levels.end());
+        levels.push_back("dram");
+        return levels;
+    }();
+    return levels;
+}
+
+size_t Roofline::capacityOf(const std::string& level)
+{
+    if (const auto detected = ceiling("capacity_" + level))
+    {
+        return static_cast<size_t>(*detected);
+    }
+
+    for (const auto& cache : CpuTopology::get().caches())
+    {
+        if (cache.type != "Instruction" && "l" + std::to_string(cache.level) == level)
+        {
+            return cache.sizeBytes;
+        }
+    }
+    return 0;
+}
+
+std::string Roofline::memoryLevelOf(size_t workingSetBytes)
+{
+    for (const auto& level : memoryLevels())
+    {
+        if (level == "dram" || workingSetBytes <= capacityOf(level))
+        {
+            return level;
+        }
+    }
+    return "dram";
+}
+
+std::string Roofline::bandwidthKey(const std::string& kernel, const std::string& level, bool allCores)
+{
+    return "bandwidth_" + kernel + "_" + level + (allCores ? "_all" : "_single");
+}
+
+std::string Roofline::flopsKey(IsaLevel level, bool simd)
+{
+    return std::string(simd ? "flops_simd_" : "flops_scalar_") + IsaSupport::name(level);
+}
+
+void Roofline::record(const std::string& key, double value)
+{
+    if (MemoryTracker::measuring())
+    {
+        return;
+    }
+
+    auto& recorded = recorded_.try_emplace(key, 0.0).first->second;
+    recorded = std::max(recorded, value);
+    ceilings_[key] = recorded;
+    save();
+}
+
+void Roofline::recordLatency(const std::string& pattern, size_t workingSetBytes, double seconds)
+{
+    if (MemoryTracker::measuring())
+    {
+        return;
+    }
+
+    const auto key = "chase_" + pattern + "_" + std::to_string(workingSetBytes);
+    const auto [recorded, inserted] = recorded_.try_emplace(key, seconds);
+    recorded->second = std::min(recorded->second, seconds);
+    ceilings_[key] = recorded->second;
+    detectHierarchy();
+    save();
+}
+
+std::optional<double> Roofline::ceiling(const std::string& key)
+{
+    const auto found = ceilings_.find(key);
+    return found != ceilings_.end() ? std::optional(found->second) : std::nullopt;
+}
+
+void Roofline::publish(benchmark::State& state, double flopsPerIteration, double bytesPerIteration,
+                       size_t workingSetBytes, double seconds, IsaLevel isaLevel, bool simd)
+{
+    const auto pause = MemoryTracker::Pause();
+    const double intensity = flopsPerIteration / bytesPerIteration;
+    state.counters["intensity"] = intensity;
+
+    const bool allCores = state.threads() > 1;
+    const auto bandwidth = ceiling(bandwidthKey("triad", memoryLevelOf(workingSetBytes), allCores));
+    const auto peak = ceiling(flopsKey(isaLevel, simd));
+    if (bandwidth && peak && seconds > 0)
+    {
+        // Counters of all threads are summed, so every thread adds its share of the attainable flop/s
+        const double attainable = std::min(*peak, intensity * *bandwidth) / state.threads();
+        const double achieved = flopsPerIteration * static_cast<double>(state.iterations()) / seconds;
+        state.counters["roofline_percent"] = 100.0 * achieved / attainable;
+    }
+}
+
+// A working set a little larger than a level still hits it for most loads, so the latency only jumps at the next
+// size or the one after. The capacity of a level is the largest working set before the jump, which is a power of two
+// at or above the actual size, and its latency the lowest one up to there. A jump has to hold for the next two working
+// sets as well, so that a single disturbed measurement does not split a level.
+std::vector<Roofline::Level> Roofline::detectLevels(const std::string& pattern, size_t maxNumOfJumps)
+{
+    const auto prefix = "chase_" + pattern + "_";
+    auto latencies = std::vector<std::pair<size_t, double>>();
+    for (const auto& [key, value] : ceilings_)
+    {
+        if (key.starts_with(prefix))
+        {
+            latencies.emplace_back(std::stoull(key.substr(prefix.size())), value);
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    auto levels = std::vector<Level>();
+    for (size_t i = 0; i < latencies.size(); i++)
+    {
+        const double seconds = latencies[i].second;
+        bool jump = levels.empty();
+        if (!jump && levels.size() <= maxNumOfJumps)
+        {
+            const auto end = latencies.begin() + std::min(i + 3, latencies.size());
+            jump = std::all_of(latencies.begin() + i, end, [&](const auto& latency) {
+                return latency.second > jumpFactor * levels.back().latencySeconds;
+            });
+        }
+
+        if (jump)
+        {
+            if (!levels.empty())
+            {
+                levels.back().capacityBytes = latencies[i - 1].first;
+            }
+            levels.push_back({0, seconds});
+        }
+        levels.back().latencySeconds = std::min(levels.back().latencySeconds, seconds);
+    }
+    return levels;
+}
+
+// Levels of the random chase are the caches followed by dram, with as many caches as the kernel reports. Beyond the
+// caches the latency keeps growing with the page walks of TLB misses. The jumps of the strided chase are the first and
+// second level TLB.
+void Roofline::detectHierarchy()
+{
+    std::erase_if(ceilings_, [](const auto& entry) {
+        return entry.first.starts_with("capacity_") || entry.first.starts_with("latency_");
+    });
+
+    const auto cacheLevels = detectLevels("random", std::max<size_t>(memoryLevels().size() - 1, 1));
+    for (size_t i = 0; i < cacheLevels.size(); i++)
+    {
+        const auto name = i + 1 < cacheLevels.size() ? "l" + std::to_string(i + 1) : std::string("dram");
+        if (cacheLevels[i].capacityBytes > 0)
+        {
+            ceilings_["capacity_" + name] = static_cast<double>(cacheLevels[i].capacityBytes);
+        }
+        ceilings_["latency_" + name] = cacheLevels[i].latencySeconds;
+    }
+
+    const auto tlbLevels = detectLevels("strided", 2);
+    for (size_t i = 0; i + 1 < tlbLevels.size(); i++)
+    {
+        ceilings_["capacity_tlb" + std::to_string(i + 1)] = static_cast<double>(tlbLevels[i].capacityBytes);
+    }
+}
+
+// Lines of 'key=value', empty lines and lines starting with '#' are skipped. A missing file is created on the first
+// record.
+void Roofline::load()
+{
+    auto file = std::ifstream(path_);
+    auto line = std::string();
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+
+        const auto separator = line.find('=');
+        if (separator == std::string::npos)
+        {
+            throw std::runtime_error("Invalid line '" + line + "' in roofline file " + path_ + "!");
+        }
+        ceilings_[line.substr(0, separator)] = std::stod(line.substr(separator + 1));
+    }
+}
+
+void Roofline::save()
+{
+    if (path_.empty())
+    {
+        return;
+    }
+
+    auto file = std::ofstream(path_);
+    if (!file)
+    {
+        throw std::runtime_error("Could not write roofline file " + path_ + "!");
+    }
+    // Capacities have to come back exactly, as they decide the memory level of a working set
+    file << std::setprecision(std::numeric_limits<double>::max_digits10);
+    file << "# Measured by 3_Roofline, bandwidths in bytes/s, peak compute in flop/s, latencies in s\n";
+    for (const auto& [key, value] : ceilings_)
+    {
+        file << key << "=" << value << "\n";
+    }
+}
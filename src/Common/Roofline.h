@@ -0,0 +1,78 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include "Common/IsaLevel.h"
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Ceilings of the machine for roofline analysis, measured by the 3_Roofline suite and kept in a file of 'key=value'
+// lines, which every suite can read with
+//   --roofline=<file>   read the ceilings from the file, the roofline suite also writes its measurements into it
+// Bandwidths in bytes/s are kept as 'bandwidth_<kernel>_<level>_<single|all>' for the STREAM kernels, the memory
+// levels l1, l2, ... and dram, and one or all cores. Peak compute in flop/s is kept as 'flops_<scalar|simd>_<isa>'.
+//
+// The latencies of pointer chasing loads in seconds are kept as 'chase_<random|strided>_<working set bytes>', and the
+// cache hierarchy detected from them as 'capacity_<level>' and 'latency_<level>' in bytes and seconds for the cache
+// levels l1, l2, ... and dram, and as 'capacity_tlb1' and 'capacity_tlb2' for the jumps of the strided chase, which
+// touches one line per page and so mostly measures the reach of the TLB levels.
+class Roofline
+{
+public:
+    static void parseArguments(int& argc, char** argv);
+
+    // Cache levels of the machine that hold data, from the first level on, followed by 'dram'
+    static const std::vector<std::string>& memoryLevels();
+
+    // Size of a cache level in bytes as detected by pointer chasing if the file has it, else as the kernel reports it,
+    // 0 for dram
+    static size_t capacityOf(const std::string& level);
+
+    // First memory level that the working set fits into
+    static std::string memoryLevelOf(size_t workingSetBytes);
+
+    static std::string bandwidthKey(const std::string& kernel, const std::string& level, bool allCores);
+    static std::string flopsKey(IsaLevel level, bool simd);
+
+    // Keeps the highest value recorded for the key in this process, replacing the one read from the file, and writes
+    // all ceilings back. Nothing is recorded during the allocation counting run.
+    static void record(const std::string& key, double value);
+
+    // Keeps the lowest latency of a load recorded for the pattern and working set in this process, detects the cache
+    // hierarchy again from all latencies of the file and writes it back
+    static void recordLatency(const std::string& pattern, size_t workingSetBytes, double seconds);
+
+    static std::optional<double> ceiling(const std::string& key);
+
+    // Adds the arithmetic intensity of a kernel in flop/byte as counter 'intensity', from its flops and the bytes it
+    // has to move from memory per iteration. If the ceilings are known, also adds 'roofline_percent', the percentage
+    // of the attainable performance min(peak flops, intensity * triad bandwidth) that the kernel achieved in the given
+    // wall time of the timed loop, with the bandwidth of the memory level that the working set fits into and the peak
+    // of the given ISA level.
+    static void publish(benchmark::State& state, double flopsPerIteration, double bytesPerIteration,
+                        size_t workingSetBytes, double seconds, IsaLevel isaLevel, bool simd);
+
+private:
+    static constexpr double jumpFactor = 1.5;
+
+    struct Level
+    {
+        size_t capacityBytes;
+        double latencySeconds;
+    };
+
+    // Splits the latencies of the pattern into levels where the latency grows by more than jumpFactor over the
+    // lowest latency of the level before, at most maxNumOfJumps times, the last level is unbounded
+    static std::vector<Level> detectLevels(const std::string& pattern, size_t maxNumOfJumps);
+    static void detectHierarchy();
+
+    static void load();
+    static void save();
+
+    inline static std::string path_;
+    inline static std::map<std::string, double> ceilings_;
+    inline static std::map<std::string, double> recorded_;
+};
@@ -0,0 +1,181 @@
+#include "Common/ScalingReporter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace
+{
+constexpr auto threadsPrefix = std::string_view("threads:");
+
+// Google Benchmark 1.8 replaced 'error_occurred' with 'skipped'
+template <typename RunType>
+bool isSkipped(const RunType& run)
+{
+    if constexpr (requires { run.skipped; })
+    {
+        return static_cast<int>(run.skipped) != 0;
+    }
+    else
+    {
+        return run.error_occurred;
+    }
+}
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const size_t middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+} // namespace
+
+ScalingReporter::ScalingReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter, bool printTable,
+                                 std::string csvPath)
+    : displayReporter_(std::move(displayReporter))
+    , printTable_(printTable)
+    , csvPath_(std::move(csvPath))
+{
+}
+
+bool ScalingReporter::ReportContext(const Context& context)
+{
+    return displayReporter_->ReportContext(context);
+}
+
+void ScalingReporter::ReportRuns(const std::vector<Run>& reports)
+{
+    displayReporter_->ReportRuns(reports);
+
+    for (const auto& run : reports)
+    {
+        if (run.run_type != Run::RT_Iteration || isSkipped(run) || run.iterations == 0)
+        {
+            continue;
+        }
+
+        // Replace the 'threads:N' component of the name to get the key of the sweep
+        auto name = run.benchmark_name();
+        const auto position = name.find(threadsPrefix);
+        if (position == std::string::npos)
+        {
+            continue;
+        }
+        const auto end = std::min(name.find('/', position), name.size());
+        const int threads = std::stoi(name.substr(position + threadsPrefix.size(), end - position - threadsPrefix.size()));
+        name.replace(position, end - position, std::string(threadsPrefix) + "*");
+
+        auto& measurement = sweeps_[name][threads];
+        measurement.threads = threads;
+        measurement.secondsPerIteration.push_back(run.real_accumulated_time / run.iterations);
+    }
+}
+
+void ScalingReporter::Finalize()
+{
+    displayReporter_->Finalize();
+
+    const auto rows = computeRows();
+    if (rows.empty())
+    {
+        return;
+    }
+
+    if (printTable_)
+    {
+        printTable(rows);
+    }
+    if (!csvPath_.empty())
+    {
+        writeCsv(rows);
+    }
+}
+
+std::vector<ScalingReporter::Row> ScalingReporter::computeRows() const
+{
+    auto rows = std::vector<Row>();
+    for (const auto& [sweep, measurements] : sweeps_)
+    {
+        // Without a 1-thread baseline, there is nothing to compare against
+        if (!measurements.contains(1) || measurements.size() < 2)
+        {
+            continue;
+        }
+
+        const double baseline = median(measurements.at(1).secondsPerIteration);
+        for (const auto& [threads, measurement] : measurements)
+        {
+            const double seconds = median(measurement.secondsPerIteration);
+            const double speedup = baseline / seconds;
+            const double karpFlatt =
+                threads > 1 ? (1.0 / speedup - 1.0 / threads) / (1.0 - 1.0 / threads) : std::nan("");
+
+            rows.push_back({
+                .sweep = sweep,
+                .threads = threads,
+                .seconds = seconds,
+                .speedup = speedup,
+                .efficiency = speedup / threads,
+                .karpFlatt = karpFlatt,
+            });
+        }
+    }
+    return rows;
+}
+
+void ScalingReporter::printTable(const std::vector<Row>& rows)
+{
+    auto& out = GetOutputStream();
+    const auto flags = out.flags();
+
+    std::string currentSweep;
+    for (const auto& row : rows)
+    {
+        if (row.sweep != currentSweep)
+        {
+            currentSweep = row.sweep;
+            out << "\nScaling of " << currentSweep << "\n";
+            out << std::setw(8) << "threads" << std::setw(16) << "time" << std::setw(10) << "speedup" << std::setw(12)
+                << "efficiency" << std::setw(12) << "karp-flatt" << "\n";
+        }
+
+        out << std::setw(8) << row.threads << std::setw(13) << std::fixed << std::setprecision(1) << row.seconds * 1e6
+            << " us" << std::setw(10) << std::setprecision(2) << row.speedup << std::setw(11) << std::setprecision(1)
+            << row.efficiency * 100.0 << "%";
+        if (row.threads > 1)
+        {
+            out << std::setw(12) << std::setprecision(3) << row.karpFlatt;
+        }
+        else
+        {
+            out << std::setw(12) << "-";
+        }
+        out << "\n";
+    }
+
+    out.flags(flags);
+}
+
+void ScalingReporter::writeCsv(const std::vector<Row>& rows) const
+{
+    std::ofstream csv(csvPath_);
+    if (!csv)
+    {
+        throw std::runtime_error("Could not open the scaling report file '" + csvPath_ + "'!");
+    }
+
+    csv << "benchmark,threads,time_s,speedup,efficiency,karp_flatt\n";
+    csv << std::setprecision(9);
+    for (const auto& row : rows)
+    {
+        csv << '"' << row.sweep << "\"," << row.threads << "," << row.seconds << "," << row.speedup << ","
+            << row.efficiency << ",";
+        if (row.threads > 1)
+        {
+            csv << row.karpFlatt;
+        }
+        csv << "\n";
+    }
+}
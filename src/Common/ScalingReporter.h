@@ -0,0 +1,49 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Forwards everything to the display reporter and additionally collects the runs of benchmarks with a 'threads:'
+// argument. At the end, it prints speedup, parallel efficiency and the Karp-Flatt serial fraction of every thread
+// sweep against its 1-thread run, and optionally writes them to a CSV file.
+class ScalingReporter : public benchmark::BenchmarkReporter
+{
+public:
+    ScalingReporter(std::unique_ptr<benchmark::BenchmarkReporter> displayReporter, bool printTable, std::string csvPath);
+
+    bool ReportContext(const Context& context) override;
+    void ReportRuns(const std::vector<Run>& reports) override;
+    void Finalize() override;
+
+private:
+    struct Measurement
+    {
+        int threads;
+        std::vector<double> secondsPerIteration;
+    };
+
+    struct Row
+    {
+        std::string sweep;
+        int threads;
+        double seconds;
+        double speedup;
+        double efficiency;
+        double karpFlatt;
+    };
+
+    std::vector<Row> computeRows() const;
+    void printTable(const std::vector<Row>& rows);
+    void writeCsv(const std::vector<Row>& rows) const;
+
+    std::unique_ptr<benchmark::BenchmarkReporter> displayReporter_;
+    const bool printTable_;
+    const std::string csvPath_;
+
+    // Keyed by the benchmark name with the thread count replaced by '*', then by the thread count
+    std::map<std::string, std::map<int, Measurement>> sweeps_;
+};
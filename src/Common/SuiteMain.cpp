@@ -0,0 +1,77 @@
+#include "Common/SuiteMain.h"
+
+#include "Common/CommandLine.h"
+#include "Common/HistogramReporter.h"
+#include "Common/LatencyHistogram.h"
+#include "Common/MemoryReporter.h"
+#include "Common/MemoryTracker.h"
+#include "Common/Preflight.h"
+#include "Common/Roofline.h"
+#include "Common/ScalingReporter.h"
+
+#include <unistd.h>
+
+#include <stdexcept>
+
+int SuiteMain::run(int argc, char** argv)
+{
+    Preflight::parseArguments(argc, argv);
+    MemoryTracker::parseArguments(argc, argv);
+    LatencyHistogram::parseArguments(argc, argv);
+    Roofline::parseArguments(argc, argv);
+    const auto scalingReportCsv = CommandLine::extractFlag(argc, argv, "scaling_report_csv").value_or("");
+    const auto format = CommandLine::findFlag(argc, argv, "benchmark_format").value_or("console");
+    const auto color = CommandLine::findFlag(argc, argv, "benchmark_color").value_or("auto");
+    const auto tabular = CommandLine::findFlag(argc, argv, "benchmark_counters_tabular").value_or("false");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    if (!Preflight::run())
+    {
+        return 1;
+    }
+    MemoryTracker::install();
+
+    // The scaling table is only printed next to the console output, so that JSON and CSV output stay parseable
+    auto displayReporter = std::make_unique<HistogramReporter>(
+        std::make_unique<MemoryReporter>(createDisplayReporter(format, color, tabular)));
+    auto reporter = ScalingReporter(std::move(displayReporter), format == "console", scalingReportCsv);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
+
+// Mirrors the display reporter Google Benchmark creates from its own flags
+std::unique_ptr<benchmark::BenchmarkReporter> SuiteMain::createDisplayReporter(const std::string& format,
+                                                                               const std::string& color,
+                                                                               const std::string& tabular)
+{
+    if (format == "console")
+    {
+        int options = benchmark::ConsoleReporter::OO_None;
+        if (color == "true" || color == "yes" || (color == "auto" && isatty(STDOUT_FILENO)))
+        {
+            options |= benchmark::ConsoleReporter::OO_Color;
+        }
+        if (tabular == "true" || tabular == "yes")
+        {
+            options |= benchmark::ConsoleReporter::OO_Tabular;
+        }
+        return std::make_unique<benchmark::ConsoleReporter>(static_cast<benchmark::ConsoleReporter::OutputOptions>(options));
+    }
+    if (format == "json")
+    {
+        return std::make_unique<benchmark::JSONReporter>();
+    }
+    if (format == "csv")
+    {
+        BENCHMARK_DISABLE_DEPRECATED_WARNING
+        return std::make_unique<benchmark::CSVReporter>();
+        BENCHMARK_RESTORE_DEPRECATED_WARNING
+    }
+    throw std::runtime_error("Unknown benchmark format '" + format + "'!");
+}
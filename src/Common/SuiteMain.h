@@ -0,0 +1,30 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+
+// Entry point shared by all suites: runs the preflight checks around the usual Google Benchmark main, and reports the
+// parallel scaling of thread sweeps, the memory use of every benchmark and latency distributions. Additional flags
+//   --scaling_report_csv=<file>      also write the scaling report of thread sweeps as CSV
+//   --memory_tracking=true           count allocations in an additional run of every benchmark
+//   --latency_histogram_out=<file>   write the latency distributions that benchmarks record as CSV
+//   --roofline=<file>                machine ceilings for the roofline counters, see Roofline
+class SuiteMain
+{
+public:
+    static int run(int argc, char** argv);
+
+private:
+    static std::unique_ptr<benchmark::BenchmarkReporter> createDisplayReporter(const std::string& format,
+                                                                              const std::string& color,
+                                                                              const std::string& tabular);
+};
+
+#define SUITE_MAIN()                                                                                                   \
+    int main(int argc, char** argv)                                                                                    \
+    {                                                                                                                  \
+        return SuiteMain::run(argc, argv);                                                                             \
+    }                                                                                                                  \
+    int main(int, char**)
@@ -0,0 +1,163 @@
+#include "Common/ThreadPlacement.h"
+
+#include "Common/CpuTopology.h"
+
+#include <omp.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+
+const char* ThreadPlacement::name(Policy policy)
+{
+    switch (policy)
+    {
+    case Policy::None:
+        return "none";
+    case Policy::Compact:
+        return "compact";
+    case Policy::Scatter:
+        return "scatter";
+    case Policy::PhysicalCores:
+        return "physical-cores";
+    case Policy::OnePerL3:
+        return "one-per-l3";
+    }
+    throw std::runtime_error("Unknown thread placement policy!");
+}
+
+std::vector<int> ThreadPlacement::cpusFor(Policy policy, int numThreads)
+{
+    const auto& allowed = allowedCpus();
+    if (policy == Policy::None)
+    {
+        return std::vector<int>(numThreads, -1);
+    }
+
+    auto cpus = std::vector<CpuTopology::Cpu>();
+    for (const auto& cpu : CpuTopology::get().cpus())
+    {
+        if (std::find(allowed.begin(), allowed.end(), cpu.id) != allowed.end())
+        {
+            cpus.push_back(cpu);
+        }
+    }
+
+    // Rank of each core within its package, so that scatter can interleave packages
+    auto coreRank = std::map<std::pair<int, int>, int>();
+    for (const auto& cpu : cpus)
+    {
+        coreRank.try_emplace({cpu.packageId, cpu.coreId}, 0);
+    }
+    auto coresInPackage = std::map<int, int>();
+    for (auto& [core, rank] : coreRank)
+    {
+        rank = coresInPackage[core.first]++;
+    }
+
+    const auto byCore = [](const auto& a, const auto& b) {
+        return std::tie(a.packageId, a.coreId, a.smtIndex) < std::tie(b.packageId, b.coreId, b.smtIndex);
+    };
+
+    switch (policy)
+    {
+    case Policy::Compact:
+        std::sort(cpus.begin(), cpus.end(), byCore);
+        break;
+    case Policy::Scatter:
+        std::sort(cpus.begin(), cpus.end(), [&](const auto& a, const auto& b) {
+            const int rankA = coreRank[{a.packageId, a.coreId}];
+            const int rankB = coreRank[{b.packageId, b.coreId}];
+            return std::tie(a.smtIndex, rankA, a.packageId) < std::tie(b.smtIndex, rankB, b.packageId);
+        });
+        break;
+    case Policy::PhysicalCores:
+        std::erase_if(cpus, [](const auto& cpu) { return cpu.smtIndex != 0; });
+        std::sort(cpus.begin(), cpus.end(), byCore);
+        break;
+    case Policy::OnePerL3:
+        std::sort(cpus.begin(), cpus.end(), byCore);
+        std::stable_sort(cpus.begin(), cpus.end(), [](const auto& a, const auto& b) { return a.l3Id < b.l3Id; });
+        cpus.erase(std::unique(cpus.begin(), cpus.end(), [](const auto& a, const auto& b) { return a.l3Id == b.l3Id; }),
+                   cpus.end());
+        break;
+    case Policy::None:
+        break;
+    }
+
+    if (cpus.empty())
+    {
+        return std::vector<int>(numThreads, -1);
+    }
+
+    auto placement = std::vector<int>(numThreads);
+    for (int thread = 0; thread < numThreads; thread++)
+    {
+        placement[thread] = cpus[thread % cpus.size()].id;
+    }
+    return placement;
+}
+
+void ThreadPlacement::pinCurrentThread(int cpu)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (cpu >= 0)
+    {
+        CPU_SET(cpu, &cpuSet);
+    }
+    else
+    {
+        for (const int allowedCpu : allowedCpus())
+        {
+            CPU_SET(allowedCpu, &cpuSet);
+        }
+    }
+
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) != 0)
+    {
+        throw std::runtime_error("Could not set the affinity of a benchmark thread to cpu " + std::to_string(cpu) + "!");
+    }
+}
+
+void ThreadPlacement::placeTeam(Policy policy, int numThreads)
+{
+    const auto cpus = cpusFor(policy, numThreads);
+
+#pragma omp parallel num_threads(numThreads)
+    {
+        pinCurrentThread(cpus.at(omp_get_thread_num()));
+    }
+    numOfPlacedThreads_ = policy != Policy::None ? numThreads : 0;
+}
+
+void ThreadPlacement::unplaceTeam()
+{
+    if (numOfPlacedThreads_ > 0)
+    {
+        placeTeam(Policy::None, numOfPlacedThreads_);
+    }
+}
+
+const std::vector<int>& ThreadPlacement::allowedCpus()
+{
+    // Captured on first use, before any benchmark thread has been pinned
+    static const auto cpus = [] {
+        auto result = std::vector<int>();
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        sched_getaffinity(0, sizeof(cpuSet), &cpuSet);
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        {
+            if (CPU_ISSET(cpu, &cpuSet))
+            {
+                result.push_back(cpu);
+            }
+        }
+        return result;
+    }();
+    return cpus;
+}
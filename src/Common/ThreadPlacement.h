@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+
+// Maps benchmark threads onto cpus following the usual OpenMP placement policies, using the topology from /sys.
+// Only the cpus the process is allowed to run on at startup (see --preflight_pin) are used.
+class ThreadPlacement
+{
+public:
+    enum class Policy
+    {
+        None,          // Leave placement to the scheduler
+        Compact,       // Fill all hardware threads of a core before moving to the next core
+        Scatter,       // Spread over packages and cores first, use SMT siblings last
+        PhysicalCores, // One thread per core, never share a core between threads
+        OnePerL3,      // One thread per L3 cache domain
+    };
+
+    static const char* name(Policy policy);
+
+    // Cpu for each of the threads, or -1 if the thread may run on any allowed cpu. When a policy has fewer cpus than
+    // threads, the cpus are reused round-robin.
+    static std::vector<int> cpusFor(Policy policy, int numThreads);
+
+    // Restricts the calling thread to the given cpu, or to all allowed cpus for -1
+    static void pinCurrentThread(int cpu);
+
+    // Pins the threads of an OpenMP team of the given size following the policy. The runtime reuses the same threads
+    // for the parallel regions after it as long as the team size does not change.
+    static void placeTeam(Policy policy, int numThreads);
+
+    // Lets the team of the last placement run on all allowed cpus again, so that the benchmarks after it are not
+    // confined to its cpus
+    static void unplaceTeam();
+
+private:
+    static const std::vector<int>& allowedCpus();
+
+    inline static int numOfPlacedThreads_ = 0;
+};
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""Folds 'perf script' output into stacks and renders them as an SVG flame graph, without external tools.
+
+    perf script -i perf.data | flamegraph.py --folded stacks.folded --svg flamegraph.svg --title "LoopTiling/64/64"
+"""
+
+import argparse
+import hashlib
+import html
+import re
+import sys
+from collections import defaultdict
+
+OFFSET_PATTERN = re.compile(r"\+0x[0-9a-f]+$")
+
+
+def fold(lines):
+    """Counts samples per call stack. Frames of a sample are listed leaf first, one per line, after a header line."""
+    stacks = defaultdict(int)
+    command, frames = None, []
+
+    def flush():
+        if command is not None and frames:
+            stacks[";".join([command] + frames[::-1])] += 1
+
+    for line in lines:
+        line = line.rstrip("\n")
+        if not line.strip():
+            flush()
+            command, frames = None, []
+        elif not line[0].isspace():
+            flush()
+            command, frames = line.split()[0], []
+        else:
+            fields = line.split(None, 1)
+            if len(fields) < 2:
+                continue
+            symbol = fields[1].rsplit(" (", 1)[0]
+            symbol = OFFSET_PATTERN.sub("", symbol)
+            frames.append(symbol.replace(";", ":"))
+    flush()
+
+    return stacks
+
+
+def build_tree(stacks):
+    root = {"name": "all", "value": 0, "children": {}}
+    for stack, count in stacks.items():
+        root["value"] += count
+        node = root
+        for frame in stack.split(";"):
+            node = node["children"].setdefault(frame, {"name": frame, "value": 0, "children": {}})
+            node["value"] += count
+    return root
+
+
+def frame_color(name):
+    digest = hashlib.md5(name.encode()).digest()
+    return f"rgb({205 + digest[0] % 50},{digest[1] % 200},{digest[2] % 55})"
+
+
+def render_svg(stacks, title, width=1200, frame_height=16, min_width=0.1):
+    root = build_tree(stacks)
+    total = max(root["value"], 1)
+    scale = (width - 20) / total
+
+    def depth_of(node):
+        return 1 + max((depth_of(child) for child in node["children"].values()), default=0)
+
+    depth = depth_of(root)
+    height = (depth + 3) * frame_height + 20
+    rects = []
+
+    def draw(node, x, level):
+        node_width = node["value"] * scale
+        if node_width < min_width:
+            return
+        y = height - (level + 2) * frame_height
+        percent = 100.0 * node["value"] / total
+        label = html.escape(node["name"])
+        tooltip = f"{label} ({node['value']} samples, {percent:.2f}%)"
+        visible_characters = int(node_width / 7)
+        text = label
+        if len(node["name"]) > visible_characters:
+            text = html.escape(node["name"][:max(visible_characters - 2, 0)]) + ".."
+        rects.append(
+            f'<g><title>{tooltip}</title>'
+            f'<rect x="{10 + x:.2f}" y="{y}" width="{node_width:.2f}" height="{frame_height - 1}" fill="{frame_color(node["name"])}" rx="2"/>'
+            + (f'<text x="{13 + x:.2f}" y="{y + frame_height - 5}">{text}</text>' if visible_characters > 2 else "")
+            + "</g>"
+        )
+        child_x = x
+        for child in sorted(node["children"].values(), key=lambda child: child["name"]):
+            draw(child, child_x, level + 1)
+            child_x += child["value"] * scale
+
+    draw(root, 0.0, 0)
+
+    return "\n".join([
+        f'<svg xmlns="http://www.w3.org/2000/svg" width="{width}" height="{height}" font-family="monospace" font-size="11">',
+        '<rect width="100%" height="100%" fill="#f8f8f8"/>',
+        f'<text x="{width / 2}" y="20" text-anchor="middle" font-size="15">{html.escape(title)}</text>',
+        *rects,
+        "</svg>",
+    ])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", nargs="?", help="'perf script' output (default: stdin)")
+    parser.add_argument("--folded", help="write the folded stacks to this file")
+    parser.add_argument("--svg", help="write the flame graph to this file")
+    parser.add_argument("--title", default="Flame Graph")
+    args = parser.parse_args()
+
+    with (open(args.input) if args.input else sys.stdin) as lines:
+        stacks = fold(lines)
+
+    if not stacks:
+        print("No samples found, was the measured region reached?", file=sys.stderr)
+        return 1
+
+    if args.folded:
+        with open(args.folded, "w") as folded:
+            for stack, count in sorted(stacks.items()):
+                folded.write(f"{stack} {count}\n")
+
+    if args.svg:
+        with open(args.svg, "w") as svg:
+            svg.write(render_svg(stacks, args.title))
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
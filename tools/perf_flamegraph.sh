@@ -0,0 +1,40 @@
+#!/bin/sh
+# Samples a benchmark binary with 'perf record' only inside the ProfilingRegion of its benchmarks, and renders the
+# samples as folded stacks and an SVG flame graph.
+#
+#   perf_flamegraph.sh OUTPUT_PREFIX CALL_GRAPH EXECUTABLE [ARGUMENTS...]
+#
+# CALL_GRAPH is 'fp' (needs a build with BENCHMARK_SUITE_FRAME_POINTERS=ON) or 'dwarf'. Writes OUTPUT_PREFIX.data,
+# OUTPUT_PREFIX.folded and OUTPUT_PREFIX.svg.
+set -e
+
+OUTPUT_PREFIX="$1"
+CALL_GRAPH="$2"
+EXECUTABLE="$3"
+shift 3
+
+case "$CALL_GRAPH" in
+fp) CALL_GRAPH_OPTION="--call-graph=fp" ;;
+dwarf) CALL_GRAPH_OPTION="--call-graph=dwarf,16384" ;;
+*)
+    echo "Unknown call graph mode '$CALL_GRAPH', expected fp or dwarf!" >&2
+    exit 1
+    ;;
+esac
+
+TOOLS_FOLDER="$(dirname "$0")"
+FIFO_FOLDER="$(mktemp -d)"
+trap 'rm -rf "$FIFO_FOLDER"' EXIT
+mkfifo "$FIFO_FOLDER/ctl" "$FIFO_FOLDER/ack"
+mkdir -p "$(dirname "$OUTPUT_PREFIX")"
+
+# Recording starts disabled, the benchmark enables it around its timed loop through the control fifos
+PERF_CTL_FIFO="$FIFO_FOLDER/ctl" PERF_ACK_FIFO="$FIFO_FOLDER/ack" \
+    perf record $CALL_GRAPH_OPTION --delay=-1 --control="fifo:$FIFO_FOLDER/ctl,$FIFO_FOLDER/ack" \
+    --output="$OUTPUT_PREFIX.data" -- "$EXECUTABLE" "$@"
+
+perf script --input="$OUTPUT_PREFIX.data" 2>/dev/null |
+    python3 "$TOOLS_FOLDER/flamegraph.py" --folded "$OUTPUT_PREFIX.folded" --svg "$OUTPUT_PREFIX.svg" \
+        --title "$(basename "$EXECUTABLE") $*"
+
+echo "Flame graph written to $OUTPUT_PREFIX.svg"
@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+"""Local benchmark result store with statistical comparison between runs.
+
+Results are kept in a JSON-lines file, one record per benchmark repetition, keyed by
+git SHA, build variant, binary, benchmark name, benchmark arguments, label and machine fingerprint.
+The label takes part because some benchmarks resolve their arguments to sizes on the machine
+and show only the resolved sizes there.
+
+    result_store.py ingest ./build/2_SudokuSolverOpenMP.json
+    result_store.py list
+    result_store.py compare --baseline <sha> --contender <sha>
+    result_store.py compare --baseline variant=Release --contender variant=PGO
+
+The comparison uses a two-sided Mann-Whitney U test over the repetitions of each
+benchmark, so run the binaries with '--benchmark_repetitions' of at least 5.
+"""
+
+import argparse
+import datetime
+import hashlib
+import json
+import math
+import os
+import subprocess
+import sys
+from collections import defaultdict
+
+DEFAULT_STORE = os.path.join(".", "build", "benchmark_results.jsonl")
+
+# Context entries describing the machine, used to build the fingerprint
+FINGERPRINT_KEYS = [
+    "host_name", "num_cpus", "mhz_per_cpu", "caches",  # reported by Google Benchmark
+    "cpu_model", "smt_topology", "numa_layout", "kernel",  # reported by the preflight checks
+]
+
+TIME_UNIT_TO_NS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def git_sha():
+    try:
+        sha = subprocess.check_output(["git", "rev-parse", "HEAD"], stderr=subprocess.DEVNULL, text=True).strip()
+        dirty = subprocess.call(["git", "diff", "--quiet", "HEAD"], stderr=subprocess.DEVNULL) != 0
+        return sha + ("-dirty" if dirty else "")
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def machine_fingerprint(context):
+    machine = {key: context[key] for key in FINGERPRINT_KEYS if key in context}
+    return hashlib.sha1(json.dumps(machine, sort_keys=True).encode()).hexdigest()[:12]
+
+
+def split_run_name(run_name):
+    """Split 'Fixture/Method/4/8' into ('Fixture/Method', '4/8')."""
+    parts = run_name.split("/")
+    for index, part in enumerate(parts):
+        if index > 0 and (part.lstrip("-").isdigit() or ":" in part):
+            return "/".join(parts[:index]), "/".join(parts[index:])
+    return run_name, ""
+
+
+def load_store(path):
+    if not os.path.exists(path):
+        return []
+    with open(path) as store:
+        return [json.loads(line) for line in store if line.strip()]
+
+
+def ingest(args):
+    with open(args.input) as input_file:
+        report = json.load(input_file)
+
+    context = report["context"]
+    sha = args.sha or git_sha()
+    binary = args.binary or os.path.basename(context.get("executable", "unknown"))
+    fingerprint = machine_fingerprint(context)
+    timestamp = context.get("date", datetime.datetime.now().isoformat())
+
+    records = []
+    for run in report["benchmarks"]:
+        if run.get("run_type", "iteration") != "iteration" or run.get("error_occurred"):
+            continue
+
+        scale = TIME_UNIT_TO_NS[run.get("time_unit", "ns")]
+        benchmark, benchmark_args = split_run_name(run["run_name"])
+        records.append({
+            "sha": sha,
+            "variant": args.variant,
+            "timestamp": timestamp,
+            "binary": binary,
+            "benchmark": benchmark,
+            "args": benchmark_args,
+            "label": run.get("label", ""),
+            "fingerprint": fingerprint,
+            "repetition": run.get("repetition_index", 0),
+            "iterations": run["iterations"],
+            "real_time_ns": run["real_time"] * scale,
+            "cpu_time_ns": run["cpu_time"] * scale,
+        })
+
+    os.makedirs(os.path.dirname(os.path.abspath(args.store)), exist_ok=True)
+    with open(args.store, "a") as store:
+        for record in records:
+            store.write(json.dumps(record, sort_keys=True) + "\n")
+
+    print(f"Ingested {len(records)} runs of '{binary}' ({args.variant}) at {sha[:12]} (machine {fingerprint}) into {args.store}")
+
+
+def list_runs(args):
+    summary = defaultdict(lambda: [0, set()])
+    for record in load_store(args.store):
+        key = (record["timestamp"][:19], record["sha"][:12], record.get("variant", ""), record["fingerprint"],
+               record["binary"])
+        summary[key][0] += 1
+        summary[key][1].add(record["benchmark"])
+
+    print(f"{'date':<20}{'sha':<14}{'variant':<12}{'machine':<14}{'binary':<28}{'runs':>6}{'benchmarks':>12}")
+    for (date, sha, variant, fingerprint, binary), (runs, benchmarks) in sorted(summary.items()):
+        print(f"{date:<20}{sha:<14}{variant:<12}{fingerprint:<14}{binary:<28}{runs:>6}{len(benchmarks):>12}")
+
+
+def parse_selector(selector):
+    """'abc123' selects by SHA prefix, 'key=value' selects by any record field."""
+    key, separator, value = selector.partition("=")
+    return (key, value) if separator else ("sha", selector)
+
+
+def matches(record, selectors):
+    for key, value in selectors:
+        field = str(record.get(key, ""))
+        if not (field.startswith(value) if key == "sha" else field == value):
+            return False
+    return True
+
+
+def mann_whitney_u(x, y):
+    """Two-sided Mann-Whitney U test with tie correction, using the normal approximation.
+
+    Returns the U statistic of x and the p-value.
+    """
+    n1, n2 = len(x), len(y)
+    combined = sorted([(value, 0) for value in x] + [(value, 1) for value in y])
+
+    ranks = [0.0] * len(combined)
+    tie_term = 0.0
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2.0 + 1.0
+        ties = j - i + 1
+        tie_term += ties**3 - ties
+        i = j + 1
+
+    rank_sum_x = sum(rank for rank, (_, group) in zip(ranks, combined) if group == 0)
+    u = rank_sum_x - n1 * (n1 + 1) / 2.0
+
+    n = n1 + n2
+    mean_u = n1 * n2 / 2.0
+    variance_u = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance_u <= 0:
+        return u, 1.0
+
+    z = (abs(u - mean_u) - 0.5) / math.sqrt(variance_u)
+    return u, min(1.0, math.erfc(max(z, 0.0) / math.sqrt(2.0)))
+
+
+def median(values):
+    ordered = sorted(values)
+    middle = len(ordered) // 2
+    return ordered[middle] if len(ordered) % 2 else (ordered[middle - 1] + ordered[middle]) / 2.0
+
+
+def collect_samples(records, selectors, metric):
+    samples = defaultdict(list)
+    for record in records:
+        if matches(record, selectors):
+            key = (record["binary"], record["benchmark"], record["args"], record.get("label", ""),
+                   record["fingerprint"])
+            samples[key].append(record[metric])
+    return samples
+
+
+def compare(args):
+    records = [record for record in load_store(args.store) if not args.binary or record["binary"] == args.binary]
+    metric = f"{args.metric}_ns"
+    baseline = collect_samples(records, [parse_selector(selector) for selector in args.baseline], metric)
+    contender = collect_samples(records, [parse_selector(selector) for selector in args.contender], metric)
+
+    common_keys = sorted(set(baseline) & set(contender))
+    if not common_keys:
+        print("No benchmark was recorded for both selections on the same machine.", file=sys.stderr)
+        return 1
+
+    print(f"{'benchmark':<64}{'baseline':>14}{'contender':>14}{'change':>10}{'p-value':>10}  verdict")
+
+    regressions = 0
+    for key in common_keys:
+        binary, benchmark, benchmark_args, label, _ = key
+        x, y = baseline[key], contender[key]
+        name = f"{binary}:{benchmark}" + (f"/{benchmark_args}" if benchmark_args else "")
+        name += f" [{label}]" if label else ""
+
+        baseline_median, contender_median = median(x), median(y)
+        change = (contender_median - baseline_median) / baseline_median if baseline_median else 0.0
+
+        if min(len(x), len(y)) < args.min_samples:
+            p_value, verdict = float("nan"), "too few repetitions"
+        else:
+            _, p_value = mann_whitney_u(x, y)
+            if p_value >= args.alpha or abs(change) < args.threshold:
+                verdict = "~"
+            elif change > 0:
+                verdict = "REGRESSION"
+                regressions += 1
+            else:
+                verdict = "IMPROVEMENT"
+
+        print(f"{name:<64}{baseline_median:>12.0f}ns{contender_median:>12.0f}ns{change:>+10.1%}{p_value:>10.4f}  {verdict}")
+
+    return 1 if regressions and args.fail_on_regression else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--store", default=DEFAULT_STORE, help="JSON-lines result store (default: %(default)s)")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    ingest_parser = subparsers.add_parser("ingest", help="add a Google Benchmark JSON report to the store")
+    ingest_parser.add_argument("input", help="file written with --benchmark_out_format=json")
+    ingest_parser.add_argument("--sha", help="git SHA of the measured tree (default: HEAD of the working copy)")
+    ingest_parser.add_argument("--binary", help="binary name (default: taken from the report context)")
+    ingest_parser.add_argument("--variant", default="", help="build variant, e.g. Release, LTO or PGO")
+    ingest_parser.set_defaults(func=ingest)
+
+    list_parser = subparsers.add_parser("list", help="summarize the stored runs")
+    list_parser.set_defaults(func=list_runs)
+
+    compare_parser = subparsers.add_parser("compare", help="flag statistically significant changes between two runs")
+    compare_parser.add_argument("--baseline", nargs="+", required=True, help="SHA prefix or key=value selectors")
+    compare_parser.add_argument("--contender", nargs="+", required=True, help="SHA prefix or key=value selectors")
+    compare_parser.add_argument("--binary", help="only compare benchmarks of this binary")
+    compare_parser.add_argument("--metric", choices=["real_time", "cpu_time"], default="real_time")
+    compare_parser.add_argument("--alpha", type=float, default=0.05, help="significance level (default: %(default)s)")
+    compare_parser.add_argument("--threshold", type=float, default=0.02,
+                                help="minimum relative change of the median to report (default: %(default)s)")
+    compare_parser.add_argument("--min-samples", type=int, default=5, help="minimum repetitions per side")
+    compare_parser.add_argument("--fail-on-regression", action="store_true", help="exit with 1 if a regression is found")
+    compare_parser.set_defaults(func=compare)
+
+    args = parser.parse_args()
+    return args.func(args) or 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())